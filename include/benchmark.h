@@ -12,6 +12,14 @@ typedef enum {
     NEARLY_SORTED
 } DataPattern;
 
+// Element types for benchmark_typed_by_size
+typedef enum {
+    KEY_INT64,
+    KEY_UINT64,
+    KEY_FLOAT,
+    KEY_DOUBLE
+} KeyType;
+
 // Algorithm complexity categories for optimized benchmarking
 typedef enum {
     COMPLEXITY_QUADRATIC,   // O(n^2): Selection, Bubble, Insertion
@@ -23,25 +31,86 @@ typedef enum {
 typedef struct {
     double time_sec;         // Time in seconds
     uint64_t time_ns;        // Time in nanoseconds
-    SortStats stats;         // Comparison and swap counts
+    SortStats stats;         // Operation counts (zero outside the instrumented build)
 } BenchmarkResult;
 
+// Worker count for the parallel engines; 0 selects all online CPUs
+void benchmark_set_thread_count(int threads);
+int benchmark_thread_count(void);
+
+/**
+ * Sort output is always checked in O(n): parallel order scan plus a multiset
+ * fingerprint of the input. Full verification also compares every result
+ * with a qsort reference (slow at large sizes; off by default).
+ */
+void benchmark_set_full_verification(bool enabled);
+
+/**
+ * Open hardware counters (cycles, instructions, branch/L1d/LLC/dTLB misses)
+ * around every timed sort; their per-run means, IPC and misses per element
+ * are added to the CSVs. Returns the number of counters available; with 0
+ * the benchmark runs as usual and the counter columns stay empty.
+ */
+int benchmark_enable_perf_counters(void);
+
+/**
+ * Hygiene mode: pin the benchmark thread and pool workers to CPUs, pre-fault
+ * and mlock the benchmark arrays (with transparent huge pages if asked), and
+ * measure every case twice: warm, then cold after evicting the last-level
+ * cache. The CSV Cache column labels the two rows. Returns the CPU the
+ * benchmark thread is pinned to, or -1 if pinning is unavailable.
+ */
+int benchmark_set_hygiene(bool enabled, bool huge_pages);
+
+/**
+ * Run selection for run_all_benchmarks. Lists are comma-separated names as
+ * they appear in the CSVs (case-insensitive, a trailing '*' matches any
+ * suffix); NULL selects everything. benchmark_select_patterns returns false,
+ * leaving the selection unchanged, if an item names no pattern. Sizes
+ * outside [min_size, max_size] are dropped from the sweeps, and pattern runs
+ * are clamped into the range (0 leaves a bound open).
+ */
+void benchmark_select_algorithms(const char *list);
+bool benchmark_select_patterns(const char *list);
+void benchmark_set_size_range(long long min_size, long long max_size);
+
+/**
+ * Time budgets in seconds (0: unlimited). Each size sweep extrapolates its
+ * measured times to the next size and stops once the projected case no
+ * longer fits the algorithm's or the run's remaining budget; pattern runs
+ * shrink to a measured size that fits. Budget left by a cut-short algorithm
+ * extends the per-case time budget of later cases that need more trials.
+ */
+void benchmark_set_time_budgets(double per_algorithm, double total);
+
 double benchmark_sort(void (*sort_func)(int*, int), int *arr, int n);
 
-// Enhanced benchmark with statistics (nanosecond precision)
-BenchmarkResult benchmark_sort_stats(SortStats (*sort_func)(int*, int), int *arr, int n);
+// One timed sort with its operation counts (nanosecond precision)
+BenchmarkResult benchmark_sort_stats(void (*sort_func)(int*, int), int *arr, int n);
 
 void run_all_benchmarks(bool include_large_inputs);
 
+// `threads` is only recorded in the CSV Threads column (1 for serial engines)
 void benchmark_by_size(void (*sort_func)(int*, int), const char *name,
                        DataPattern pattern, AlgorithmComplexity complexity,
-                       bool include_large_inputs);
+                       bool include_large_inputs, int threads);
 
 void benchmark_by_pattern(void (*sort_func)(int*, int), const char *name,
                           AlgorithmComplexity complexity,
-                          bool include_large_inputs);
+                          bool include_large_inputs, int threads);
+
+// Size sweep over typed keys (sort_func receives an array of `type`), written to size_benchmark.csv
+void benchmark_typed_by_size(void (*sort_func)(void *, int), const char *name,
+                             KeyType type, DataPattern pattern,
+                             bool include_large_inputs);
+
+// Record sorts (radix/merge/quick x Record32/SoA/Record64) on random keys, written to size_benchmark.csv
+void benchmark_record_sweep(bool include_large_inputs);
+
+// Out-of-core sort of generated on-disk inputs, verified and written to external_benchmark.csv in GB/s
+void benchmark_external_sort(bool include_large_inputs);
 
-// Run stats benchmark (comparison/swap counts)
+// Operation counts for the ten core algorithms (needs bin/benchmark_instrumented)
 void run_stats_benchmark(void);
 
 #endif
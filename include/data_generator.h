@@ -1,8 +1,35 @@
 #ifndef DATA_GENERATOR_H
 #define DATA_GENERATOR_H
 
+#include <stddef.h>
+#include <stdint.h>
 #include "benchmark.h"
 
+/**
+ * Every generator is counter-based: element i of a pattern is a pure
+ * function of (seed, pattern, i), so a given seed reproduces the same
+ * inputs on every run and for every thread count. Large arrays are
+ * filled in fixed-size chunks by a thread pool.
+ */
+
+// Seed used until data_generator_set_seed is called
+#define DATA_GENERATOR_DEFAULT_SEED 20240101ULL
+
+void data_generator_set_seed(uint64_t seed);
+uint64_t data_generator_seed(void);
+
+// Worker count for filling large arrays; 0 selects all online CPUs
+void data_generator_set_threads(int threads);
+
+/**
+ * Directory for the generate_data cache (NULL, the default, disables it).
+ * Arrays of 1M or more elements are stored keyed by (pattern, size, seed)
+ * and mapped back in on later runs instead of being regenerated. Mostly
+ * useful for keeping exact inputs around between builds: the counter-based
+ * generator is usually faster than mapping a cached file back in.
+ */
+void data_generator_set_cache_dir(const char *dir);
+
 /**
  * Generate random data
  * Values range from 0 to 999999
@@ -29,13 +56,31 @@ void generate_reverse_sorted(int *arr, int n);
 void generate_nearly_sorted(int *arr, int n, int swaps);
 
 /**
- * Unified data generation function
+ * Unified data generation function (served from the dataset cache when enabled)
  * @param arr: target array
  * @param n: array size
  * @param pattern: desired data pattern
  */
 void generate_data(int *arr, int n, DataPattern pattern);
 
+/**
+ * Typed counterparts of generate_data for the typed radix sorts.
+ * RANDOM spans the full 64-bit range for integers, [-1e6, 1e6) for float
+ * and [-1e9, 1e9) for double; the other patterns are ordered around zero.
+ */
+void generate_data_i64(int64_t *arr, int n, DataPattern pattern);
+void generate_data_u64(uint64_t *arr, int n, DataPattern pattern);
+void generate_data_f32(float *arr, int n, DataPattern pattern);
+void generate_data_f64(double *arr, int n, DataPattern pattern);
+
+/**
+ * Write `count` native-endian keys of key_size bytes (4 or 8) to path,
+ * generated chunk by chunk so the file can be far larger than RAM.
+ * Ordered patterns run across the whole file; nearly-sorted swaps stay
+ * within 1M-element chunks. Returns 0 on success, -1 on failure.
+ */
+int generate_data_file(const char *path, long long count, size_t key_size, DataPattern pattern);
+
 /**
  * Copy array for benchmark purposes
  * Ensures each algorithm tests the same data
@@ -0,0 +1,52 @@
+#ifndef EXTERNAL_SORT_H
+#define EXTERNAL_SORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Out-of-core sort for binary files of native-endian int32 / int64 keys.
+ *
+ * 1. The input is read in budget-sized chunks with large sequential reads.
+ * 2. Each chunk is sorted by the radix engine and spilled to an unlinked
+ *    temp file (one run per chunk).
+ * 3. Runs are k-way merged through a loser tree. Every run has two input
+ *    buffers; a background I/O thread refills one while the merge drains
+ *    the other, and writes the output the same way. If the budget cannot
+ *    give every run its buffers, runs are merged in several passes.
+ */
+
+typedef enum {
+    EXTERNAL_INT32,
+    EXTERNAL_INT64
+} ExternalKeyType;
+
+// Memory budget used when ExternalSortConfig.memory_budget is 0
+#define EXTERNAL_DEFAULT_BUDGET ((size_t)256 << 20)
+
+typedef struct {
+    size_t memory_budget;   // Bytes for run buffers and merge buffers (0: default)
+    const char *temp_dir;   // Directory for spilled runs (NULL: TMPDIR or /tmp)
+    int threads;            // Workers for in-memory run sorting (<= 1: serial)
+} ExternalSortConfig;
+
+typedef struct {
+    uint64_t elements;
+    int runs;               // Runs produced by the first stage
+    int merge_passes;       // 0 when the input fit in one run
+    double run_seconds;     // Read + sort + spill
+    double merge_seconds;
+} ExternalSortStats;
+
+size_t external_key_size(ExternalKeyType type);
+
+/**
+ * Sort input_path into output_path (the paths must differ).
+ * config and stats may be NULL.
+ * Returns 0 on success, -1 on I/O or allocation failure (errno is set).
+ */
+int external_sort_file(const char *input_path, const char *output_path,
+                       ExternalKeyType type, const ExternalSortConfig *config,
+                       ExternalSortStats *stats);
+
+#endif
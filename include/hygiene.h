@@ -0,0 +1,30 @@
+#ifndef HYGIENE_H
+#define HYGIENE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Measurement hygiene for benchmark buffers.
+ *
+ * hygiene_alloc returns page-aligned memory that is already faulted in and,
+ * where RLIMIT_MEMLOCK allows, locked, so neither first-touch faults nor
+ * paging land in a timed region. With huge_pages it also asks for
+ * transparent huge pages (madvise), which cuts dTLB misses on large arrays.
+ * hygiene_evict_caches sweeps a scratch buffer several times the size of
+ * the last-level cache, so the next access to the benchmark data comes
+ * from DRAM.
+ */
+
+void *hygiene_alloc(size_t bytes, bool huge_pages);
+void hygiene_free(void *buffer, size_t bytes);
+
+// Buffers whose mlock failed so far (the memory is still pre-faulted)
+int hygiene_lock_failures(void);
+
+void hygiene_evict_caches(void);
+
+// Last-level cache size reported by the C library, or a fallback guess
+size_t hygiene_llc_bytes(void);
+
+#endif
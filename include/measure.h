@@ -0,0 +1,55 @@
+#ifndef MEASURE_H
+#define MEASURE_H
+
+#include <stdbool.h>
+
+/**
+ * Repeated-trial timing.
+ *
+ * A trial callback prepares its input, times one run and returns the
+ * elapsed seconds (negative on failure). measure_trials runs the warmup
+ * trials, then timed trials until the configured count is reached and,
+ * in auto mode, until the 95% confidence interval of the mean is narrow
+ * enough relative to the mean. A per-case time budget keeps long runs
+ * (large inputs, quadratic sorts) at a single trial.
+ */
+
+typedef struct {
+    int warmup;             // Untimed trials before measuring
+    int repetitions;        // Timed trials (the minimum in auto mode)
+    int max_repetitions;    // Cap on timed trials in auto mode
+    double target_ci;       // Auto mode: stop at CI half-width / mean <= this (0: off)
+    double time_budget;     // Seconds per case; no new trial starts once it is spent
+} MeasureConfig;
+
+#define MEASURE_DEFAULT_CONFIG {1, 3, 50, 0.05, 1.0}
+
+typedef struct {
+    int runs;
+    double min;
+    double median;
+    double mean;
+    double p95;
+    double stddev;          // Sample standard deviation (0 for a single run)
+    double ci95;            // Half-width of the 95% confidence interval of the mean
+} TimingStats;
+
+typedef double (*TrialFn)(void *ctx);
+
+void measure_set_config(const MeasureConfig *config);
+const MeasureConfig *measure_config(void);
+
+/**
+ * Returns stats with runs == 0 if no trial succeeded.
+ */
+TimingStats measure_trials(TrialFn trial, void *ctx);
+
+// True while measure_trials is running a warmup trial (lets trials skip side statistics)
+bool measure_in_warmup(void);
+
+// CSV columns written after Threads, and the matching row fields
+#define MEASURE_CSV_HEADER "Runs,Min,Median,Mean,P95,Stddev,CI95"
+#define MEASURE_CSV_FORMAT "%d,%.9f,%.9f,%.9f,%.9f,%.9f,%.9f"
+#define MEASURE_CSV_ARGS(s) (s).runs, (s).min, (s).median, (s).mean, (s).p95, (s).stddev, (s).ci95
+
+#endif
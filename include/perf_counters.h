@@ -0,0 +1,48 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * Hardware performance counters around a measured region (Linux
+ * perf_event_open, user space only, including threads spawned inside the
+ * region). Each counter is opened on its own, so a machine or VM that lacks
+ * some events (or all of them) still reports the rest; missing counters are
+ * flagged invalid rather than failing the benchmark.
+ */
+
+typedef enum {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_BRANCH_MISSES,
+    PERF_L1D_MISSES,
+    PERF_LLC_MISSES,
+    PERF_DTLB_MISSES,
+    PERF_COUNTER_COUNT
+} PerfCounter;
+
+typedef struct {
+    uint64_t values[PERF_COUNTER_COUNT];    // Scaled for multiplexing
+    bool valid[PERF_COUNTER_COUNT];
+} PerfSample;
+
+/**
+ * Open every counter the kernel allows. Returns the number opened
+ * (0 when counters are unavailable: no PMU, perf_event_paranoid, seccomp,
+ * or not Linux). Safe to call more than once.
+ */
+int perf_counters_open(void);
+
+void perf_counters_close(void);
+
+const char *perf_counter_name(PerfCounter counter);
+
+/**
+ * Reset and start / stop the open counters. perf_counters_stop adds the
+ * region's counts into *sample and marks them valid.
+ */
+void perf_counters_start(void);
+void perf_counters_stop(PerfSample *sample);
+
+#endif
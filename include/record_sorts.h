@@ -0,0 +1,44 @@
+#ifndef RECORD_SORTS_H
+#define RECORD_SORTS_H
+
+#include <stdint.h>
+
+/**
+ * Key/payload record sorts.
+ *
+ * The engines in sorts.h move bare ints. These move a signed key together
+ * with its payload (a row id, an index, a pointer cast to an integer), in
+ * two layouts:
+ *   - array of structs: Record32 / Record64, key and payload side by side
+ *   - struct of arrays: separate key and value columns of equal length
+ *
+ * Radix and merge are stable (equal keys keep their input order);
+ * quick is not.
+ */
+
+typedef struct {
+    int32_t key;
+    uint32_t value;
+} Record32;
+
+typedef struct {
+    int64_t key;
+    uint64_t value;
+} Record64;
+
+// Array of structs, 32-bit key + 32-bit payload (8 bytes per record)
+void record32_radix_sort(Record32 *records, int n);   // LSD, 4 x 8-bit passes
+void record32_merge_sort(Record32 *records, int n);   // Bottom-up, one scratch buffer
+void record32_quick_sort(Record32 *records, int n);   // Hoare partition, random pivot
+
+// Array of structs, 64-bit key + 64-bit payload (16 bytes per record)
+void record64_radix_sort(Record64 *records, int n);   // LSD, 8 x 8-bit passes
+void record64_merge_sort(Record64 *records, int n);
+void record64_quick_sort(Record64 *records, int n);
+
+// Struct of arrays: keys[i] owns values[i]; both columns are permuted together
+void record_soa_radix_sort(int32_t *keys, uint32_t *values, int n);
+void record_soa_merge_sort(int32_t *keys, uint32_t *values, int n);
+void record_soa_quick_sort(int32_t *keys, uint32_t *values, int n);
+
+#endif
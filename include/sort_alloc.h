@@ -0,0 +1,33 @@
+#ifndef SORT_ALLOC_H
+#define SORT_ALLOC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Accounting allocator for the sorting engines.
+ *
+ * Every scratch buffer an engine needs goes through sort_malloc /
+ * sort_calloc / sort_free, which keep process-wide counts of allocations,
+ * bytes requested and live bytes (thread-safe; the parallel engines
+ * allocate from pool workers). The benchmark resets the counters around
+ * each timed run to get the run's allocation count, total bytes and peak
+ * auxiliary footprint.
+ */
+
+typedef struct {
+    uint64_t allocations;       // Successful sort_malloc / sort_calloc calls
+    uint64_t bytes_requested;   // Sum of their sizes
+    uint64_t peak_bytes;        // Highest live total since the last reset, above its level then
+} SortAllocStats;
+
+void *sort_malloc(size_t bytes);
+void *sort_calloc(size_t count, size_t size);
+void sort_free(void *ptr);
+
+// Zero the counts; the peak restarts from the bytes live right now
+void sort_alloc_reset(void);
+
+SortAllocStats sort_alloc_read(void);
+
+#endif
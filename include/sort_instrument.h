@@ -0,0 +1,65 @@
+#ifndef SORT_INSTRUMENT_H
+#define SORT_INSTRUMENT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sorts.h"
+
+/**
+ * Operation-count hooks for the sorting engines.
+ *
+ * Each engine is written once against the macros below. In the timed build
+ * they expand to nothing (SORT_CMP to its bare condition), so the generated
+ * code is unchanged. Building with -DSORT_INSTRUMENT (bin/benchmark_instrumented)
+ * turns them into increments of one process-wide SortStats.
+ *
+ * Reads and writes are key loads and stores as written in the source, in
+ * the array being sorted or in key scratch buffers; counter and offset
+ * tables are not keys. Auxiliary bytes come from the sort_alloc accounting
+ * (peak bytes held at once). The counters are plain globals: counts from
+ * multithreaded engines are approximate.
+ */
+
+#ifdef SORT_INSTRUMENT
+
+extern SortStats sort_counters;
+
+#define SORT_COUNT(field, k) ((void)(sort_counters.field += (uint64_t)(k)))
+
+#else
+
+// sizeof keeps the operand "used" without evaluating it
+#define SORT_COUNT(field, k) ((void)sizeof(k))
+
+#endif
+
+// One key comparison that loads `loads` keys from memory; evaluates to `cond`
+#define SORT_CMP(loads, cond) \
+    (SORT_COUNT(comparisons, 1), SORT_COUNT(reads, loads), (cond))
+
+// Comparisons done without a branch (min/max, sorting networks, counted flags)
+#define SORT_COMPARES(k) SORT_COUNT(comparisons, k)
+
+// Element exchanges: two reads and two writes each
+#define SORT_SWAPS(k) \
+    (SORT_COUNT(swaps, k), SORT_COUNT(reads, 2 * (k)), SORT_COUNT(writes, 2 * (k)))
+
+// Element copies from one slot to another (shifts, merges, scatters, memcpy)
+#define SORT_MOVES(k) \
+    (SORT_COUNT(moves, k), SORT_COUNT(reads, k), SORT_COUNT(writes, k))
+
+#define SORT_READS(k) SORT_COUNT(reads, k)
+#define SORT_WRITES(k) SORT_COUNT(writes, k)
+
+/**
+ * True in the instrumented build. Elsewhere sort_stats_read always
+ * returns zeros.
+ */
+bool sort_stats_enabled(void);
+
+// Zero every counter (call before the sort being measured)
+void sort_stats_reset(void);
+
+SortStats sort_stats_read(void);
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef SORT_KERNELS_H
+#define SORT_KERNELS_H
+
+#include <stdbool.h>
+
+/**
+ * Small-block kernels shared by the merge and quick engines.
+ *
+ * On x86 CPUs with AVX2 these run bitonic sorting networks in registers
+ * (8 ints per register, up to 8 registers); elsewhere they fall back to
+ * scalar insertion sort / merge. The check happens once, at run time.
+ */
+
+// Largest block small_sort handles with a single network
+#define SORT_KERNEL_MAX 64
+
+/**
+ * True when the AVX2 kernels are in use on this CPU
+ */
+bool sort_kernels_use_simd(void);
+
+/**
+ * Sort arr[0, n); n <= SORT_KERNEL_MAX uses the 8/16/32/64 networks,
+ * larger n falls back to insertion sort
+ */
+void small_sort(int *arr, int n);
+
+/**
+ * Merge sorted a[0, m) and b[0, l) into out[0, m + l).
+ * out must not overlap either input.
+ */
+void merge_kernel(const int *a, int m, const int *b, int l, int *out);
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef SORT_TUNING_H
+#define SORT_TUNING_H
+
+/**
+ * Runtime tuning profile for the sorting engines.
+ *
+ * Cutoffs and sizes that depend on the host (cache sizes, core count) are
+ * read from here when a sort starts, instead of being compiled in. Every
+ * parameter starts at the engine's built-in default. A profile written by
+ * `./bin/benchmark --tune` replaces the defaults: load it with
+ * sort_tuning_load, or set SORT_TUNING=<file> in the environment, which
+ * the engines load the first time they read a parameter.
+ *
+ * Profile files hold one "name = value" line per parameter; '#' starts a
+ * comment. Values are clamped into each parameter's valid range.
+ */
+
+typedef enum {
+    TUNE_QUICK_SMALL_SORT,          // quick_sort: ranges this small go to small_sort
+    TUNE_MERGE_RUN_SIZE,            // merge sorts: leaf run length sorted by small_sort
+    TUNE_INTRO_INSERTION,           // intro_sort: ranges below this go to insertion sort
+    TUNE_BUCKET_TARGET,             // bucket_sort: target keys per bucket
+    TUNE_RADIX_DIGIT_BITS,          // radix_sort: digit width (8, 11 or 16) from the cutoff up
+    TUNE_RADIX_WIDE_CUTOFF,         // radix_sort: smallest n that uses the tuned digit width
+    TUNE_PARALLEL_QUICK_CUTOFF,     // parallel_quick_sort: serial at or below this n
+    TUNE_PARALLEL_QUICK_GRAIN,      // parallel_quick_sort: tasks this small stop splitting
+    TUNE_PARALLEL_MERGE_CUTOFF,
+    TUNE_PARALLEL_RADIX_CUTOFF,
+    TUNE_PARALLEL_SAMPLE_CUTOFF,
+    TUNE_PARALLEL_COUNTING_CUTOFF,
+    SORT_TUNING_COUNT
+} SortTunable;
+
+int sort_tuning_get(SortTunable param);
+
+// Clamps into the parameter's range; returns the value stored
+int sort_tuning_set(SortTunable param, int value);
+
+// Back to the built-in defaults
+void sort_tuning_reset(void);
+
+const char *sort_tuning_name(SortTunable param);
+int sort_tuning_default(SortTunable param);
+
+/**
+ * Apply a profile file. Unknown names and malformed lines are skipped.
+ * Returns the number of values applied, or -1 if the file cannot be read.
+ */
+int sort_tuning_load(const char *path);
+
+/**
+ * Write every current value to path, preceded by `comment` (one "# " line
+ * per line of it; may be NULL). Returns 0 on success, -1 on failure.
+ */
+int sort_tuning_save(const char *path, const char *comment);
+
+#endif
@@ -3,29 +3,98 @@
 
 #include <stdint.h>
 
-// Statistics for sort operations
+// Partition schemes for quick_sort_with_partition
+typedef enum {
+    QUICK_PARTITION_LOMUTO,  // Branchy Lomuto loop (quick_sort)
+    QUICK_PARTITION_BLOCK    // Branchless BlockQuicksort partition
+} QuickPartitionScheme;
+
+// Built-in gap sequences for shell_sort_sequence
+typedef enum {
+    SHELL_GAPS_SHELL,      // n/2, n/4, ..., 1 (shell_sort)
+    SHELL_GAPS_CIURA,      // 1, 4, 10, 23, 57, ..., 1750, then x2.25
+    SHELL_GAPS_TOKUDA,     // ceil((9^k - 4^k) / (5 * 4^(k-1)))
+    SHELL_GAPS_SEDGEWICK,  // 1, 5, 19, 41, 109, ... (Sedgewick 1986)
+    SHELL_GAPS_PRATT       // 2^p * 3^q
+} ShellGapSequence;
+
+// Operation counts from the instrumented build (see sort_instrument.h)
 typedef struct {
     uint64_t comparisons;
-    uint64_t swaps;
+    uint64_t swaps;         // Element exchanges
+    uint64_t moves;         // Element copies (shifts, merges, scatters)
+    uint64_t reads;         // Key loads from the array or key scratch
+    uint64_t writes;        // Key stores
+    uint64_t aux_bytes;     // Peak auxiliary heap bytes
 } SortStats;
 
+// Engines sort_auto dispatches to
+typedef enum {
+    SORT_AUTO_NONE,          // Already ascending: nothing to do
+    SORT_AUTO_REVERSE,       // Descending: reversed in place
+    SORT_AUTO_INSERTION,     // insertion_sort
+    SORT_AUTO_COUNTING,      // counting_sort_range
+    SORT_AUTO_MERGE,         // merge_sort_bottom_up
+    SORT_AUTO_INTRO,         // intro_sort
+    SORT_AUTO_RADIX          // radix_sort
+} SortAutoEngine;
+
+// What sort_auto measured and chose on its last call in this thread
+typedef struct {
+    SortAutoEngine engine;
+    int n;
+    long long range;        // max - min + 1 (0 when not scanned)
+    int runs;               // Maximal non-descending runs
+    int sample_size;        // Evenly spaced keys sampled for duplicates (0: not needed)
+    int sample_distinct;    // Distinct keys among them
+    const char *reason;
+} SortAutoDecision;
+
 // Basic sorting algorithms - O(n^2)
 void selection_sort(int *arr, int n);
 void bubble_sort(int *arr, int n);
 void insertion_sort(int *arr, int n);
 
-// Versions with statistics tracking
-SortStats bubble_sort_stats(int *arr, int n);
-
 // Advanced sorting algorithms - O(n log n)
 void merge_sort(int *arr, int n);
+void merge_sort_bottom_up(int *arr, int n);   // One n-sized scratch buffer, small_sort leaf runs (merge_run_size)
 void quick_sort(int *arr, int n);
+void quick_sort_with_partition(int *arr, int n, QuickPartitionScheme scheme);
 void heap_sort(int *arr, int n);
+void heap_sort_dary(int *arr, int n, int arity);  // arity 2, 4 or 8; iterative Floyd sift with prefetch
+void intro_sort(int *arr, int n);           // Default comparison sort: ninther pivots, heap fallback
 
 // Special sorting algorithms
 void shell_sort(int *arr, int n);           // O(n^(3/2)) or better
+void shell_sort_sequence(int *arr, int n, ShellGapSequence sequence);
+void shell_sort_with_gaps(int *arr, int n, const int *gaps, int gap_count);  // gaps ascending
 void counting_sort(int *arr, int n, int max_val);  // O(n + k)
-void radix_sort(int *arr, int n);           // O(d * (n + k))
+void counting_sort_range(int *arr, int n, int threads);  // O(n + (max - min)), any int range
+void radix_sort(int *arr, int n);           // O(d * (n + k)), base 256
 void bucket_sort(int *arr, int n);          // O(n + k)
 
+// Parallel sorting algorithms (threads <= 1 falls back to the serial engine)
+void parallel_quick_sort(int *arr, int n, int threads);
+void parallel_merge_sort(int *arr, int n, int threads);
+void parallel_radix_sort(int *arr, int n, int threads);
+void parallel_sample_sort(int *arr, int n, int threads);  // Splitter-tree classify, per-bucket intro sort
+
+/**
+ * Input-aware entry point: one pass for the key range and run count plus a
+ * small strided sample for duplicates, then the engine that wins on that
+ * shape of input (see src/sorts/auto.c for the rules).
+ */
+void sort_auto(int *arr, int n);
+SortAutoDecision sort_auto_last_decision(void);
+const char *sort_auto_engine_name(SortAutoEngine engine);  // The engine's benchmark name
+
+// LSD radix engine: digit_bits is 8, 11 or 16 (4, 3 or 2 passes over 32-bit keys)
+void radix_sort_bits(int *arr, int n, int digit_bits, int threads);
+
+// Typed LSD radix (8-bit digits) over order-preserving unsigned key transforms
+void radix_sort_i64(int64_t *arr, int n);   // Sign bit flipped
+void radix_sort_u64(uint64_t *arr, int n);
+void radix_sort_f32(float *arr, int n);     // IEEE total order: -NaN < -inf < -0 < +0 < +inf < +NaN
+void radix_sort_f64(double *arr, int n);
+
 #endif
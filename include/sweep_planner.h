@@ -0,0 +1,78 @@
+#ifndef SWEEP_PLANNER_H
+#define SWEEP_PLANNER_H
+
+#include <stdbool.h>
+
+/**
+ * Time-budgeted size sweeps.
+ *
+ * A SweepFit collects the median run time of every size measured in a
+ * series and extrapolates to larger sizes with a local power law
+ * t = c * n^k. The exponent comes from the two largest sizes that ran long
+ * enough to time reliably; until there are two, the complexity class's
+ * exponent stands in.
+ *
+ * The planner keeps two budgets: one per algorithm (restarted by
+ * sweep_planner_begin_algorithm) and one for the whole run. A case whose
+ * projected cost exceeds what is left is skipped, and so is the rest of
+ * its series. When an algorithm is cut short, its unspent budget goes to a
+ * reserve. Later cases draw on the reserve to stretch their per-case time
+ * budget, so cases whose confidence interval has not converged get more
+ * repetitions.
+ */
+
+#define SWEEP_FIT_MAX_POINTS 32
+
+typedef struct {
+    int count;
+    int sizes[SWEEP_FIT_MAX_POINTS];        // Ascending
+    double seconds[SWEEP_FIT_MAX_POINTS];   // Median seconds per run
+    double prior_exponent;                  // Used until two sizes are timed reliably
+} SweepFit;
+
+typedef struct {
+    int skipped_cases;
+    int unprojected_cases;      // Skipped before their series had a point to project from
+    double skipped_seconds;     // Projected cost of the other skipped cases
+    double reserve_spent;       // Seconds past the per-case budget paid from the reserve
+    double spent;               // Seconds charged to the run budget
+} SweepPlannerTotals;
+
+void sweep_fit_init(SweepFit *fit, double prior_exponent);
+
+// Sizes must be added in ascending order; points beyond the capacity are dropped
+void sweep_fit_add(SweepFit *fit, int n, double seconds);
+
+// Projected seconds per run at n (negative while the fit has no points)
+double sweep_fit_predict(const SweepFit *fit, int n);
+
+// Budgets in seconds; 0 leaves a budget unlimited. Also resets the totals.
+void sweep_planner_set_budgets(double per_algorithm, double total);
+bool sweep_planner_active(void);
+double sweep_planner_algorithm_budget(void);
+double sweep_planner_total_budget(void);
+
+void sweep_planner_begin_algorithm(void);
+
+// Hands the unspent budget of a cut-short algorithm to the reserve
+void sweep_planner_end_algorithm(void);
+
+// Seconds left under the tighter of the two budgets (INFINITY when unlimited)
+double sweep_planner_remaining(void);
+
+// Record a case skipped at its projected cost (the algorithm counts as cut short);
+// a negative cost marks a case with no projection, skipped because the budget ran out
+void sweep_planner_skip(double projected_seconds);
+
+// Seconds of reserve the next case may add to its base time budget
+double sweep_planner_grant(double base_budget);
+
+/**
+ * Charge a finished case. Time beyond base_budget is paid from the grant
+ * first and the rest from the current algorithm's budget.
+ */
+void sweep_planner_charge(double seconds, double base_budget, double granted);
+
+SweepPlannerTotals sweep_planner_totals(void);
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+/**
+ * Work-stealing thread pool used by the parallel sort engines.
+ *
+ * Every worker (including the thread that calls thread_pool_wait, which acts
+ * as worker 0) owns a deque of tasks. Workers pop their own deque LIFO and
+ * steal FIFO from the others when it runs dry. A task describes an index
+ * range [begin, end] over a shared context and may submit further tasks.
+ */
+typedef struct ThreadPool ThreadPool;
+
+typedef void (*ThreadPoolTaskFn)(ThreadPool *pool, void *ctx, int begin, int end);
+
+/**
+ * Number of online CPUs (at least 1)
+ */
+int thread_pool_default_threads(void);
+
+/**
+ * Pin the calling thread, and worker i of every pool created afterwards, to
+ * the i-th CPU (wrapping) of the process's current affinity mask, so the
+ * scheduler cannot migrate a measurement. Returns the caller's CPU, or -1
+ * if pinning is unavailable (not Linux, or sched_setaffinity failed).
+ */
+int thread_pool_pin_threads(void);
+
+/**
+ * Create a pool with `threads` workers; threads - 1 pthreads are spawned,
+ * the caller of thread_pool_wait is the remaining one.
+ * Returns NULL on allocation or thread creation failure.
+ */
+ThreadPool *thread_pool_create(int threads);
+
+void thread_pool_destroy(ThreadPool *pool);
+
+int thread_pool_size(const ThreadPool *pool);
+
+/**
+ * Index of the calling worker in [0, thread_pool_size), 0 for foreign threads
+ */
+int thread_pool_worker_index(const ThreadPool *pool);
+
+/**
+ * Queue a task on the calling worker's deque
+ */
+void thread_pool_submit(ThreadPool *pool, ThreadPoolTaskFn fn, void *ctx, int begin, int end);
+
+/**
+ * Run tasks on the calling thread until every submitted task has finished
+ */
+void thread_pool_wait(ThreadPool *pool);
+
+/**
+ * Run fn(pool, ctx, i, i) for every i in [0, count) and wait for completion
+ */
+void thread_pool_parallel_for(ThreadPool *pool, int count, ThreadPoolTaskFn fn, void *ctx);
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef TUNER_H
+#define TUNER_H
+
+/**
+ * Host auto-tuner (--tune).
+ *
+ * Measures each sort_tuning.h parameter on this machine, one after another,
+ * so later parameters are tuned with the earlier winners in place:
+ *
+ * - Engine sizes (small-sort and insertion cutoffs, merge run length,
+ *   bucket target, radix digit width) are swept over candidate values on
+ *   random input, and the fastest median wins.
+ * - Crossovers (wide radix digits, every parallel engine against its
+ *   serial fallback) are timed on a ladder of sizes. The cutoff is the
+ *   smallest size from which the alternative wins at every larger size.
+ *
+ * Every timing goes to results/tuning.csv. The tuned values are applied to
+ * the running process and written to profile_path as a sort_tuning profile.
+ * Returns 0 on success, -1 if the profile cannot be written.
+ */
+int run_tuning(const char *profile_path);
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef VERIFY_H
+#define VERIFY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * O(n) verification of sort output, parallel over `threads` workers.
+ *
+ * A sort is correct if its output is ascending and holds the same multiset
+ * of keys as its input. The order check is a parallel scan; the multiset
+ * check compares a fingerprint of the input, taken when it is generated,
+ * with one of the output. The fingerprint combines the count with the sum
+ * and xor of a 64-bit mix of every key, so it does not depend on order.
+ */
+
+typedef struct {
+    uint64_t count;
+    uint64_t sum;           // Sum of mixed keys (wraps)
+    uint64_t xor_mix;       // Xor of a second, independent mix of the keys
+} Fingerprint;
+
+/**
+ * Fingerprint n keys of key_size bytes (4 or 8), hashed by bit pattern
+ */
+Fingerprint fingerprint_keys(const void *arr, int n, size_t key_size, int threads);
+
+/**
+ * Fold n more keys into fp (start from a zeroed Fingerprint), serially.
+ * For inputs streamed in chunks, e.g. key files; matches fingerprint_keys
+ * over the same keys.
+ */
+void fingerprint_update(Fingerprint *fp, const void *keys, int n, size_t key_size);
+
+bool fingerprint_equal(Fingerprint a, Fingerprint b);
+
+/**
+ * Ascending-order checks; return the index of the first out-of-order
+ * element (arr[i - 1] > arr[i]), or -1 if the array is sorted.
+ */
+int find_unsorted_int(const int *arr, int n, int threads);
+
+// Generic version for typed keys: compare follows qsort's contract
+int find_unsorted(const void *arr, int n, size_t elem_size,
+                  int (*compare)(const void *, const void *), int threads);
+
+#endif
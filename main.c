@@ -1,7 +1,16 @@
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "benchmark.h"
+#include "data_generator.h"
+#include "measure.h"
+#include "perf_counters.h"
+#include "external_sort.h"
+#include "hygiene.h"
+#include "sort_instrument.h"
+#include "sort_tuning.h"
+#include "tuner.h"
 #include "visualizer.h"
 
 static void print_usage(const char *program_name) {
@@ -9,7 +18,50 @@ static void print_usage(const char *program_name) {
     printf("  --plot-only            Regenerate charts from existing CSV files\n");
     printf("  --no-large-sizes       Limit efficient algorithms to <= 1M elements\n");
     printf("  --include-large-sizes  Explicitly enable extended sizes (default)\n");
-    printf("  --stats-only           Run only the stats benchmark (comparisons/swaps)\n");
+    printf("  --stats-only           Run only the operation count benchmark (instrumented build)\n");
+    printf("  --threads N            Worker threads for parallel sorts and data generation (default: all CPUs)\n");
+    printf("  --seed N               Seed for the generated inputs (default: %llu)\n",
+           (unsigned long long)DATA_GENERATOR_DEFAULT_SEED);
+    printf("  --warmup N             Untimed trials before measuring (default: 1)\n");
+    printf("  --repeat N             Timed trials per case (default: 3; minimum in auto mode)\n");
+    printf("  --max-repeat N         Cap on trials in auto mode (default: 50)\n");
+    printf("  --ci PCT               Auto mode: repeat until the 95%% CI is within PCT%% of the mean\n");
+    printf("                         (default: 5; 0 disables auto mode)\n");
+    printf("  --time-budget SEC      Stop starting new trials once a case has used SEC seconds (default: 1)\n");
+    printf("  --algorithms LIST      Run only these algorithms (CSV names, comma-separated; Name* matches a prefix)\n");
+    printf("  --patterns LIST        Run only these input patterns (Random,Sorted,ReverseSorted,NearlySorted)\n");
+    printf("  --min-size N           Skip sweep sizes below N elements\n");
+    printf("  --max-size N           Skip sweep sizes above N elements (pattern runs are capped at N)\n");
+    printf("  --algorithm-budget SEC Stop an algorithm's sweeps once the next size is projected past SEC seconds\n");
+    printf("  --total-budget SEC     Same, for the whole run; unused budget buys extra trials\n");
+    printf("  --perf                 Record hardware counters (IPC, cache/TLB/branch misses) per run\n");
+    printf("  --full-verify          Also check every result against a qsort reference\n");
+    printf("  --hygiene              Pin threads, pre-fault and mlock arrays, time every case warm and cold\n");
+    printf("  --huge-pages           With --hygiene, also request transparent huge pages (implies --hygiene)\n");
+    printf("  --data-cache DIR       Cache generated inputs (>= 1M elements) in DIR across runs\n");
+    printf("  --tune                 Tune engine cutoffs for this host, write results/tuning.conf and exit\n");
+    printf("  --tuning FILE          Load a tuning profile (as written by --tune) before benchmarking\n");
+    printf("  --external-sort IN OUT Sort a binary file of keys out of core and exit\n");
+    printf("    --key-type T         int32 (default) or int64\n");
+    printf("    --memory-mb N        Memory budget in MiB (default: %zu)\n", EXTERNAL_DEFAULT_BUDGET >> 20);
+    printf("    --temp-dir DIR       Directory for spilled runs (default: TMPDIR or /tmp)\n");
+}
+
+static int run_external_sort(const char *input_path, const char *output_path,
+                             ExternalKeyType type, ExternalSortConfig *config) {
+    printf("External sort: %s -> %s\n", input_path, output_path);
+    ExternalSortStats stats;
+    if (external_sort_file(input_path, output_path, type, config, &stats) != 0) {
+        perror("External sort failed");
+        return 1;
+    }
+    double total = stats.run_seconds + stats.merge_seconds;
+    double bytes = (double)stats.elements * (double)external_key_size(type);
+    printf("Sorted %llu keys in %.3fs (%.3f GB/s)\n",
+           (unsigned long long)stats.elements, total, total > 0 ? bytes / total / 1e9 : 0.0);
+    printf("  %d runs in %.3fs, %d merge passes in %.3fs\n",
+           stats.runs, stats.run_seconds, stats.merge_passes, stats.merge_seconds);
+    return 0;
 }
 
 int main(int argc, char *argv[]) {
@@ -18,6 +70,19 @@ int main(int argc, char *argv[]) {
     bool plot_only = false;
     bool include_large_sizes = true;
     bool stats_only = false;
+    bool perf_counters = false;
+    bool hygiene = false;
+    bool huge_pages = false;
+    bool tune = false;
+    const char *external_input = NULL;
+    const char *external_output = NULL;
+    ExternalKeyType external_type = EXTERNAL_INT32;
+    ExternalSortConfig external_config = {0, NULL, 0};
+    MeasureConfig measure = *measure_config();
+    double algorithm_budget = 0.0;
+    double total_budget = 0.0;
+    long long min_size = 0;
+    long long max_size = 0;
 
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "--plot-only") == 0) {
@@ -28,6 +93,76 @@ int main(int argc, char *argv[]) {
             include_large_sizes = false;
         } else if (strcmp(argv[i], "--stats-only") == 0) {
             stats_only = true;
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            int threads = atoi(argv[++i]);
+            benchmark_set_thread_count(threads);
+            data_generator_set_threads(threads);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            data_generator_set_seed(strtoull(argv[++i], NULL, 0));
+        } else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            measure.warmup = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            measure.repetitions = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--max-repeat") == 0 && i + 1 < argc) {
+            measure.max_repetitions = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--ci") == 0 && i + 1 < argc) {
+            measure.target_ci = atof(argv[++i]) / 100.0;
+        } else if (strcmp(argv[i], "--time-budget") == 0 && i + 1 < argc) {
+            measure.time_budget = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--algorithms") == 0 && i + 1 < argc) {
+            benchmark_select_algorithms(argv[++i]);
+        } else if (strcmp(argv[i], "--patterns") == 0 && i + 1 < argc) {
+            if (!benchmark_select_patterns(argv[++i])) {
+                printf("Unknown pattern in: %s\n\n", argv[i]);
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--min-size") == 0 && i + 1 < argc) {
+            min_size = atoll(argv[++i]);
+        } else if (strcmp(argv[i], "--max-size") == 0 && i + 1 < argc) {
+            max_size = atoll(argv[++i]);
+        } else if (strcmp(argv[i], "--algorithm-budget") == 0 && i + 1 < argc) {
+            algorithm_budget = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--total-budget") == 0 && i + 1 < argc) {
+            total_budget = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--perf") == 0) {
+            perf_counters = true;
+        } else if (strcmp(argv[i], "--full-verify") == 0) {
+            benchmark_set_full_verification(true);
+        } else if (strcmp(argv[i], "--hygiene") == 0) {
+            hygiene = true;
+        } else if (strcmp(argv[i], "--huge-pages") == 0) {
+            hygiene = true;
+            huge_pages = true;
+        } else if (strcmp(argv[i], "--data-cache") == 0 && i + 1 < argc) {
+            data_generator_set_cache_dir(argv[++i]);
+        } else if (strcmp(argv[i], "--tune") == 0) {
+            tune = true;
+        } else if (strcmp(argv[i], "--tuning") == 0 && i + 1 < argc) {
+            int applied = sort_tuning_load(argv[++i]);
+            if (applied < 0) {
+                printf("Cannot read tuning profile: %s\n", argv[i]);
+                return 1;
+            }
+            printf("Loaded %d tuning values from %s\n\n", applied, argv[i]);
+        } else if (strcmp(argv[i], "--external-sort") == 0 && i + 2 < argc) {
+            external_input = argv[++i];
+            external_output = argv[++i];
+        } else if (strcmp(argv[i], "--key-type") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "int32") == 0) {
+                external_type = EXTERNAL_INT32;
+            } else if (strcmp(argv[i], "int64") == 0) {
+                external_type = EXTERNAL_INT64;
+            } else {
+                printf("Unknown key type: %s\n\n", argv[i]);
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--memory-mb") == 0 && i + 1 < argc) {
+            external_config.memory_budget = (size_t)strtoull(argv[++i], NULL, 10) << 20;
+        } else if (strcmp(argv[i], "--temp-dir") == 0 && i + 1 < argc) {
+            external_config.temp_dir = argv[++i];
         } else if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
             print_usage(argv[0]);
             return 0;
@@ -38,7 +173,25 @@ int main(int argc, char *argv[]) {
         }
     }
 
+    measure_set_config(&measure);
+    benchmark_set_size_range(min_size, max_size);
+    benchmark_set_time_budgets(algorithm_budget, total_budget);
+
+    if (external_input != NULL) {
+        external_config.threads = benchmark_thread_count();
+        return run_external_sort(external_input, external_output, external_type, &external_config);
+    }
+
+    if (tune) {
+        return run_tuning("results/tuning.conf") == 0 ? 0 : 1;
+    }
+
     if (stats_only) {
+        if (!sort_stats_enabled()) {
+            printf("Operation counts are compiled out of this binary; "
+                   "run ./bin/benchmark_instrumented --stats-only\n");
+            return 1;
+        }
         printf("Running stats benchmark only...\n\n");
         run_stats_benchmark();
         printf("\nStats benchmark completed! Check results/stats_benchmark.csv\n");
@@ -52,6 +205,32 @@ int main(int argc, char *argv[]) {
         return 0;
     }
 
+    if (hygiene) {
+        int cpu = benchmark_set_hygiene(true, huge_pages);
+        if (cpu >= 0) {
+            printf("Hygiene mode: pinned to CPU %d, arrays pre-faulted and locked%s; "
+                   "every case runs warm and cold.\n\n", cpu, huge_pages ? ", huge pages requested" : "");
+        } else {
+            printf("Hygiene mode: CPU pinning unavailable; arrays pre-faulted and locked%s; "
+                   "every case runs warm and cold.\n\n", huge_pages ? ", huge pages requested" : "");
+        }
+    }
+
+    if (sort_stats_enabled()) {
+        printf("Note: this binary counts operations in every sort; "
+               "use ./bin/benchmark for timings.\n\n");
+    }
+
+    if (perf_counters) {
+        int available = benchmark_enable_perf_counters();
+        if (available == 0) {
+            printf("Hardware counters unavailable (no PMU access, or perf_event_paranoid too strict);\n"
+                   "counter columns will be left empty.\n\n");
+        } else {
+            printf("Hardware counters enabled (%d of %d available).\n\n", available, PERF_COUNTER_COUNT);
+        }
+    }
+
     if (include_large_sizes) {
         printf("Including extended input sizes (may take hours and require >1 GB RAM).\n\n");
     } else {
@@ -60,6 +239,11 @@ int main(int argc, char *argv[]) {
 
     run_all_benchmarks(include_large_sizes);
 
+    if (hygiene && hygiene_lock_failures() > 0) {
+        printf("Note: %d buffers could not be mlocked (RLIMIT_MEMLOCK); they were still pre-faulted.\n",
+               hygiene_lock_failures());
+    }
+
     // Generate visualization graphs
     generate_all_plots();
 
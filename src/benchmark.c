@@ -1,29 +1,41 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <time.h>
+#include <sys/resource.h>
 #include "../include/benchmark.h"
 #include "../include/sorts.h"
+#include "../include/sort_instrument.h"
+#include "../include/sort_alloc.h"
+#include "../include/record_sorts.h"
+#include "../include/external_sort.h"
 #include "../include/data_generator.h"
+#include "../include/thread_pool.h"
+#include "../include/verify.h"
+#include "../include/measure.h"
+#include "../include/perf_counters.h"
+#include "../include/hygiene.h"
+#include "../include/sweep_planner.h"
 #define ARRAY_SIZE(arr) (int)(sizeof(arr) / sizeof((arr)[0]))
 
 /* ========== Sort Result Verification Functions ========== */
 
-// Check if array is sorted in ascending order
-static bool is_sorted(const int *arr, int n) {
-    for (int i = 1; i < n; i++) {
-        if (arr[i - 1] > arr[i]) {
-            return false;
-        }
-    }
-    return true;
+// Off: O(n) order + fingerprint checks only. On: also compare against a qsort reference
+static bool full_verification = false;
+
+void benchmark_set_full_verification(bool enabled) {
+    full_verification = enabled;
 }
 
 // Comparison function for qsort
 static int compare_int(const void *a, const void *b) {
-    return (*(const int*)a - *(const int*)b);
+    int lhs = *(const int*)a;
+    int rhs = *(const int*)b;
+    return (lhs > rhs) - (lhs < rhs);
 }
 
 // Verify that sort result matches the expected output (using qsort as reference)
@@ -56,6 +68,30 @@ static bool verify_sort_result(const int *result, const int *original, int n, co
     return match;
 }
 
+/*
+ * Check a sorted int array against the fingerprint of its input, and against
+ * the qsort reference when `original` is given (full verification).
+ * Returns NULL if the result is correct, otherwise the tag to print.
+ */
+static const char *check_sort_result(const int *arr, int n, Fingerprint input,
+                                     const int *original, const char *algo_name) {
+    int threads = benchmark_thread_count();
+    int unsorted = find_unsorted_int(arr, n, threads);
+    if (unsorted >= 0) {
+        printf("\n[ERROR] %s left index %d out of order: %d > %d\n",
+               algo_name, unsorted, arr[unsorted - 1], arr[unsorted]);
+        return " [FAIL - NOT SORTED]";
+    }
+    if (!fingerprint_equal(fingerprint_keys(arr, n, sizeof(int), threads), input)) {
+        printf("\n[ERROR] %s changed the multiset of keys!\n", algo_name);
+        return " [FAIL - WRONG RESULT]";
+    }
+    if (original != NULL && !verify_sort_result(arr, original, n, algo_name)) {
+        return " [FAIL - WRONG RESULT]";
+    }
+    return NULL;
+}
+
 /* Practical default sizes for O(n log n) algorithms (<= 1,000,000) */
 static const int DEFAULT_SIZES[] = {
     100,
@@ -91,6 +127,120 @@ static const int QUADRATIC_SIZES[] = {
 #define PATTERN_SIZE_LINEARITHMIC  5000000    // O(n log n)
 #define PATTERN_SIZE_LINEAR        50000000   // O(n)
 
+// Room for the longest schedule (DEFAULT_SIZES followed by EXTENDED_SIZES)
+#define MAX_SCHEDULE_SIZES 16
+
+/* ========== Run Selection ========== */
+
+static char *algorithm_filter = NULL;   // NULL selects every algorithm
+static char *pattern_filter = NULL;     // NULL selects every pattern
+static long long min_size_filter = 0;
+static long long max_size_filter = 0;   // 0: no upper bound
+
+static const char *pattern_names[] = {
+    "Random",
+    "Sorted",
+    "ReverseSorted",
+    "NearlySorted"
+};
+
+// One list item against a name, case-insensitive; a trailing '*' matches any suffix
+static bool item_matches(const char *item, size_t length, const char *name) {
+    bool prefix = length > 0 && item[length - 1] == '*';
+    size_t compared = prefix ? length - 1 : length;
+    return strncasecmp(item, name, compared) == 0 && (prefix || name[compared] == '\0');
+}
+
+// Comma-separated list; NULL matches everything
+static bool list_matches(const char *list, const char *name) {
+    if (list == NULL) {
+        return true;
+    }
+    for (const char *item = list; *item != '\0'; ) {
+        size_t length = strcspn(item, ",");
+        if (length > 0 && item_matches(item, length, name)) {
+            return true;
+        }
+        item += length;
+        if (*item == ',') {
+            item++;
+        }
+    }
+    return false;
+}
+
+static char *replace_filter(char *filter, const char *list) {
+    free(filter);
+    return list != NULL && *list != '\0' ? strdup(list) : NULL;
+}
+
+void benchmark_select_algorithms(const char *list) {
+    algorithm_filter = replace_filter(algorithm_filter, list);
+}
+
+bool benchmark_select_patterns(const char *list) {
+    // Every item must name a pattern, so a typo cannot silently select nothing
+    for (const char *item = list != NULL ? list : ""; *item != '\0'; ) {
+        size_t length = strcspn(item, ",");
+        bool known = false;
+        for (int p = 0; p < ARRAY_SIZE(pattern_names); p++) {
+            known = known || item_matches(item, length, pattern_names[p]);
+        }
+        if (!known) {
+            return false;
+        }
+        item += length;
+        if (*item == ',') {
+            item++;
+        }
+    }
+    pattern_filter = replace_filter(pattern_filter, list);
+    return true;
+}
+
+void benchmark_set_size_range(long long min_size, long long max_size) {
+    min_size_filter = min_size > 0 ? min_size : 0;
+    max_size_filter = max_size > 0 ? max_size : 0;
+}
+
+static bool algorithm_selected(const char *name) {
+    return list_matches(algorithm_filter, name);
+}
+
+static bool pattern_selected(DataPattern pattern) {
+    return list_matches(pattern_filter, pattern_names[pattern]);
+}
+
+static bool size_selected(long long n) {
+    return n >= min_size_filter && (max_size_filter == 0 || n <= max_size_filter);
+}
+
+static int clamp_to_size_range(int n) {
+    if (max_size_filter > 0 && n > max_size_filter) {
+        n = (int)max_size_filter;
+    }
+    return n < min_size_filter ? (int)min_size_filter : n;
+}
+
+// Ascending sizes of a sweep after the size filter; max_size caps the schedule (0: none)
+static int size_schedule(AlgorithmComplexity complexity, bool include_large_inputs,
+                         int max_size, int *sizes) {
+    const int *primary = complexity == COMPLEXITY_QUADRATIC ? QUADRATIC_SIZES : DEFAULT_SIZES;
+    int primary_count = complexity == COMPLEXITY_QUADRATIC ? ARRAY_SIZE(QUADRATIC_SIZES)
+                                                           : ARRAY_SIZE(DEFAULT_SIZES);
+    int extra_count = include_large_inputs && complexity != COMPLEXITY_QUADRATIC
+                          ? ARRAY_SIZE(EXTENDED_SIZES) : 0;
+
+    int count = 0;
+    for (int i = 0; i < primary_count + extra_count; i++) {
+        int n = i < primary_count ? primary[i] : EXTENDED_SIZES[i - primary_count];
+        if ((max_size == 0 || n <= max_size) && size_selected(n) && count < MAX_SCHEDULE_SIZES) {
+            sizes[count++] = n;
+        }
+    }
+    return count;
+}
+
 static void counting_sort_wrapper(int *arr, int n) {
     if (arr == NULL || n <= 0) {
         return;
@@ -106,24 +256,387 @@ static void counting_sort_wrapper(int *arr, int n) {
     counting_sort(arr, n, max_val);
 }
 
+/* Worker count handed to the parallel engines (0 = all online CPUs) */
+static int benchmark_threads = 0;
+
+void benchmark_set_thread_count(int threads) {
+    benchmark_threads = threads > 0 ? threads : 0;
+}
+
+int benchmark_thread_count(void) {
+    return benchmark_threads > 0 ? benchmark_threads : thread_pool_default_threads();
+}
+
+static void parallel_quick_sort_wrapper(int *arr, int n) {
+    parallel_quick_sort(arr, n, benchmark_thread_count());
+}
+
+static void block_quick_sort_wrapper(int *arr, int n) {
+    quick_sort_with_partition(arr, n, QUICK_PARTITION_BLOCK);
+}
+
+static void heap_sort_4ary_wrapper(int *arr, int n) {
+    heap_sort_dary(arr, n, 4);
+}
+
+static void heap_sort_8ary_wrapper(int *arr, int n) {
+    heap_sort_dary(arr, n, 8);
+}
+
+static void shell_sort_ciura_wrapper(int *arr, int n) {
+    shell_sort_sequence(arr, n, SHELL_GAPS_CIURA);
+}
+
+static void shell_sort_tokuda_wrapper(int *arr, int n) {
+    shell_sort_sequence(arr, n, SHELL_GAPS_TOKUDA);
+}
+
+static void shell_sort_sedgewick_wrapper(int *arr, int n) {
+    shell_sort_sequence(arr, n, SHELL_GAPS_SEDGEWICK);
+}
+
+static void shell_sort_pratt_wrapper(int *arr, int n) {
+    shell_sort_sequence(arr, n, SHELL_GAPS_PRATT);
+}
+
+static void counting_sort_range_wrapper(int *arr, int n) {
+    counting_sort_range(arr, n, 1);
+}
+
+static void parallel_counting_sort_wrapper(int *arr, int n) {
+    counting_sort_range(arr, n, benchmark_thread_count());
+}
+
+static void parallel_merge_sort_wrapper(int *arr, int n) {
+    parallel_merge_sort(arr, n, benchmark_thread_count());
+}
+
+static void parallel_radix_sort_wrapper(int *arr, int n) {
+    parallel_radix_sort(arr, n, benchmark_thread_count());
+}
+
+static void parallel_sample_sort_wrapper(int *arr, int n) {
+    parallel_sample_sort(arr, n, benchmark_thread_count());
+}
+
+static void radix_sort_11bit_wrapper(int *arr, int n) {
+    radix_sort_bits(arr, n, 11, 1);
+}
+
+static void radix_sort_16bit_wrapper(int *arr, int n) {
+    radix_sort_bits(arr, n, 16, 1);
+}
+
+/* ========== Measurement Hygiene ========== */
+
+static bool hygiene_enabled = false;
+static bool hygiene_huge_pages = false;
+static bool cold_cache = false;     // Evict the caches before every run of the current pass
+
+int benchmark_set_hygiene(bool enabled, bool huge_pages) {
+    hygiene_enabled = enabled;
+    hygiene_huge_pages = enabled && huge_pages;
+    return enabled ? thread_pool_pin_threads() : -1;
+}
+
+// Benchmark arrays: pre-faulted and locked in hygiene mode
+static void *bench_alloc(size_t bytes) {
+    return hygiene_enabled ? hygiene_alloc(bytes, hygiene_huge_pages) : malloc(bytes);
+}
+
+static void bench_free(void *buffer, size_t bytes) {
+    if (hygiene_enabled) {
+        hygiene_free(buffer, bytes);
+    } else {
+        free(buffer);
+    }
+}
+
+// Hygiene mode measures every case twice: warm (input just copied in) and cold (caches evicted)
+static int cache_pass_count(void) {
+    return hygiene_enabled ? 2 : 1;
+}
+
+static void set_cache_pass(int pass) {
+    cold_cache = pass == 1;
+}
+
+static const char *cache_label(void) {
+    if (!hygiene_enabled) {
+        return "";
+    }
+    return cold_cache ? "cold" : "warm";
+}
+
+/* ========== Sweep Planning ========== */
+
+// Random-input size sweep of the last algorithm; its pattern runs are projected from it
+static SweepFit algorithm_fit;
+static const char *algorithm_fit_name = NULL;
+
+void benchmark_set_time_budgets(double per_algorithm, double total) {
+    sweep_planner_set_budgets(per_algorithm, total);
+}
+
+// Growth exponent assumed until a sweep has two reliable timings (n log n is ~n^1.15 here)
+static double complexity_exponent(AlgorithmComplexity complexity) {
+    switch (complexity) {
+        case COMPLEXITY_QUADRATIC:    return 2.0;
+        case COMPLEXITY_LINEARITHMIC: return 1.15;
+        case COMPLEXITY_LINEAR:       return 1.0;
+    }
+    return 1.0;
+}
+
+static double now_seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+/*
+ * Projected wall time of one case (all cache passes) under measure_trials'
+ * stopping rules. Auto mode is costed at its minimum trial count: most
+ * cases converge there, and the per-case time budget caps the rest.
+ * Negative until the series has a measured point to project from.
+ */
+static double projected_cost(const SweepFit *fit, int n) {
+    if (fit->count == 0) {
+        return -1.0;
+    }
+    double run = sweep_fit_predict(fit, n);
+    const MeasureConfig *measure = measure_config();
+    int trials = measure->warmup + measure->repetitions;
+    double cost = run >= measure->time_budget ? run : fmin(run * trials, measure->time_budget + run);
+    return cost * cache_pass_count();
+}
+
+// An unprojected case (negative cost) fits while any budget is left
+static bool fits_budget(double cost) {
+    double remaining = sweep_planner_remaining();
+    return remaining > 0.0 && cost <= remaining;
+}
+
+// Record sizes[from..count) of a series as skipped once its next case no longer fits
+static void skip_rest_of_series(const SweepFit *fit, const char *name,
+                                const int *sizes, int from, int count) {
+    if (fit->count == 0) {
+        printf("  Skipping %s from %d elements: time budget exhausted\n", name, sizes[from]);
+    } else {
+        printf("  Skipping %s from %d elements: projected %.1fs, %.1fs of time budget left\n",
+               name, sizes[from], projected_cost(fit, sizes[from]),
+               fmax(sweep_planner_remaining(), 0.0));
+    }
+    for (int i = from; i < count; i++) {
+        sweep_planner_skip(projected_cost(fit, sizes[i]));
+    }
+}
+
+// Largest of n and the fit's smaller measured sizes at which `cases` cases fit the budget (0: none)
+static int affordable_size(const SweepFit *fit, int n, int cases) {
+    if (fits_budget(cases * projected_cost(fit, n))) {
+        return n;
+    }
+    for (int i = fit->count - 1; i >= 0; i--) {
+        int smaller = fit->sizes[i];
+        if (smaller < n && size_selected(smaller) && fits_budget(cases * projected_cost(fit, smaller))) {
+            return smaller;
+        }
+    }
+    return 0;
+}
+
+/* ========== Hardware Counters ========== */
+
+// Counts of the current case, summed over its timed runs (warmup runs are kept apart)
+static bool perf_enabled = false;
+static PerfSample perf_case;
+static int perf_case_runs = 0;
+static PerfSample perf_warmup;
+static bool perf_have_warmup = false;
+
+int benchmark_enable_perf_counters(void) {
+    int opened = perf_counters_open();
+    perf_enabled = opened > 0;
+    return opened;
+}
+
+static void perf_region_begin(void) {
+    if (perf_enabled) {
+        perf_counters_start();
+    }
+}
+
+static void perf_region_end(void) {
+    if (!perf_enabled) {
+        return;
+    }
+    if (measure_in_warmup()) {
+        memset(&perf_warmup, 0, sizeof(perf_warmup));
+        perf_counters_stop(&perf_warmup);
+        perf_have_warmup = true;
+        return;
+    }
+    perf_counters_stop(&perf_case);
+    perf_case_runs++;
+}
+
+/* ========== Memory Accounting ========== */
+
+// Engine allocations (sort_alloc) and page faults of the current case, kept like the counters
+typedef struct {
+    uint64_t allocations;
+    uint64_t bytes_requested;
+    uint64_t peak_bytes;        // Largest over the runs, not a sum
+    uint64_t page_faults;       // Minor + major, every thread of the process
+} MemorySample;
+
+static MemorySample memory_case;
+static int memory_case_runs = 0;
+static MemorySample memory_warmup;
+static bool memory_have_warmup = false;
+static uint64_t region_start_faults;
+
+static uint64_t process_page_faults(void) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    return (uint64_t)usage.ru_minflt + (uint64_t)usage.ru_majflt;
+}
+
+static void memory_region_begin(void) {
+    sort_alloc_reset();
+    region_start_faults = process_page_faults();
+}
+
+static void memory_region_end(void) {
+    uint64_t faults = process_page_faults() - region_start_faults;
+    SortAllocStats alloc = sort_alloc_read();
+    MemorySample *sample = &memory_case;
+    if (measure_in_warmup()) {
+        sample = &memory_warmup;
+        memset(sample, 0, sizeof(*sample));
+        memory_have_warmup = true;
+    } else {
+        memory_case_runs++;
+    }
+    sample->allocations += alloc.allocations;
+    sample->bytes_requested += alloc.bytes_requested;
+    sample->page_faults += faults;
+    if (alloc.peak_bytes > sample->peak_bytes) {
+        sample->peak_bytes = alloc.peak_bytes;
+    }
+}
+
+// Everything recorded around a timed sort, outside the clock reads
+static void timed_region_begin(void) {
+    if (cold_cache) {
+        hygiene_evict_caches();
+    }
+    memory_region_begin();
+    perf_region_begin();
+}
+
+static void timed_region_end(void) {
+    perf_region_end();
+    memory_region_end();
+}
+
+// Measure one case, collecting its counters alongside the timing statistics
+static TimingStats measure_case(TrialFn trial, void *ctx) {
+    memset(&perf_case, 0, sizeof(perf_case));
+    perf_case_runs = 0;
+    perf_have_warmup = false;
+    memset(&memory_case, 0, sizeof(memory_case));
+    memory_case_runs = 0;
+    memory_have_warmup = false;
+
+    // Time saved by skipped sizes buys extra trials for cases that have not converged yet
+    MeasureConfig base = *measure_config();
+    double granted = sweep_planner_grant(base.time_budget);
+    if (granted > 0.0) {
+        MeasureConfig extended = base;
+        extended.time_budget += granted;
+        measure_set_config(&extended);
+    }
+    double start = now_seconds();
+    TimingStats stats = measure_trials(trial, ctx);
+    sweep_planner_charge(now_seconds() - start, base.time_budget, granted);
+    if (granted > 0.0) {
+        measure_set_config(&base);
+    }
+
+    // A warmup run over the time budget is the case's only sample; report its counters too
+    if (perf_case_runs == 0 && stats.runs > 0 && perf_have_warmup) {
+        perf_case = perf_warmup;
+        perf_case_runs = 1;
+    }
+    if (memory_case_runs == 0 && stats.runs > 0 && memory_have_warmup) {
+        memory_case = memory_warmup;
+        memory_case_runs = 1;
+    }
+    return stats;
+}
+
+#define PERF_CSV_HEADER "Cycles,Instructions,IPC,BranchMissesPerElem,L1dMissesPerElem,LLCMissesPerElem,DTLBMissesPerElem"
+
+// Mean per run; unavailable counters leave their fields empty
+static void write_perf_columns(FILE *fp, int n) {
+    const PerfSample *sample = &perf_case;
+    double runs = perf_case_runs > 0 ? (double)perf_case_runs : 1.0;
+    bool have_cycles = perf_case_runs > 0 && sample->valid[PERF_CYCLES];
+    bool have_instructions = perf_case_runs > 0 && sample->valid[PERF_INSTRUCTIONS];
+
+    if (have_cycles) {
+        fprintf(fp, ",%.0f", sample->values[PERF_CYCLES] / runs);
+    } else {
+        fprintf(fp, ",");
+    }
+    if (have_instructions) {
+        fprintf(fp, ",%.0f", sample->values[PERF_INSTRUCTIONS] / runs);
+    } else {
+        fprintf(fp, ",");
+    }
+    if (have_cycles && have_instructions && sample->values[PERF_CYCLES] > 0) {
+        fprintf(fp, ",%.3f", (double)sample->values[PERF_INSTRUCTIONS] / (double)sample->values[PERF_CYCLES]);
+    } else {
+        fprintf(fp, ",");
+    }
+    static const PerfCounter per_element[] = {
+        PERF_BRANCH_MISSES, PERF_L1D_MISSES, PERF_LLC_MISSES, PERF_DTLB_MISSES
+    };
+    for (int i = 0; i < ARRAY_SIZE(per_element); i++) {
+        if (perf_case_runs > 0 && sample->valid[per_element[i]] && n > 0) {
+            fprintf(fp, ",%.4f", sample->values[per_element[i]] / runs / n);
+        } else {
+            fprintf(fp, ",");
+        }
+    }
+}
+
 double benchmark_sort(void (*sort_func)(int*, int), int *arr, int n) {
     struct timespec start, end;
+    timed_region_begin();
     clock_gettime(CLOCK_MONOTONIC, &start);
     sort_func(arr, n);
     clock_gettime(CLOCK_MONOTONIC, &end);
+    timed_region_end();
 
     uint64_t elapsed_ns = (uint64_t)(end.tv_sec - start.tv_sec) * 1000000000ULL
                         + (uint64_t)(end.tv_nsec - start.tv_nsec);
     return (double)elapsed_ns / 1e9;
 }
 
-BenchmarkResult benchmark_sort_stats(SortStats (*sort_func)(int*, int), int *arr, int n) {
+BenchmarkResult benchmark_sort_stats(void (*sort_func)(int*, int), int *arr, int n) {
     BenchmarkResult result = {0};
     struct timespec start, end;
 
+    sort_stats_reset();
     clock_gettime(CLOCK_MONOTONIC, &start);
-    result.stats = sort_func(arr, n);
+    sort_func(arr, n);
     clock_gettime(CLOCK_MONOTONIC, &end);
+    result.stats = sort_stats_read();
 
     result.time_ns = (uint64_t)(end.tv_sec - start.tv_sec) * 1000000000ULL
                    + (uint64_t)(end.tv_nsec - start.tv_nsec);
@@ -132,75 +645,134 @@ BenchmarkResult benchmark_sort_stats(SortStats (*sort_func)(int*, int), int *arr
     return result;
 }
 
-static const char *pattern_names[] = {
-    "Random",
-    "Sorted",
-    "ReverseSorted",
-    "NearlySorted"
-};
+/* ========== Repeated trials ========== */
+
+// One trial: restore the input, then time a single sort (arr keeps the last result)
+typedef struct {
+    void (*sort_func)(int*, int);
+    int *arr;
+    const int *input;
+    int n;
+} SortTrial;
+
+static double sort_trial(void *arg) {
+    SortTrial *trial = (SortTrial *)arg;
+    memcpy(trial->arr, trial->input, (size_t)trial->n * sizeof(int));
+    return benchmark_sort(trial->sort_func, trial->arr, trial->n);
+}
+
+static void print_timing(const TimingStats *stats) {
+    if (stats->runs > 1) {
+        printf(" OK (%.4fs median, %d runs, CI +/-%.1f%%)\n", stats->median, stats->runs,
+               stats->mean > 0.0 ? 100.0 * stats->ci95 / stats->mean : 0.0);
+    } else {
+        printf(" OK (%.4fs)\n", stats->median);
+    }
+}
+
+#define MEMORY_CSV_HEADER "Allocs,AllocBytes,PeakAuxBytes,PageFaults"
+
+// Allocations, bytes and faults are means per run; the peak is the largest run's
+static void write_memory_columns(FILE *fp) {
+    if (memory_case_runs == 0) {
+        fprintf(fp, ",,,,");
+        return;
+    }
+    double runs = (double)memory_case_runs;
+    fprintf(fp, ",%.0f,%.0f,%llu,%.1f",
+            memory_case.allocations / runs, memory_case.bytes_requested / runs,
+            (unsigned long long)memory_case.peak_bytes, memory_case.page_faults / runs);
+}
+
+// Time is the median; trial statistics, counters, memory use and the cache pass follow Threads
+static void write_timing_row(FILE *fp, const char *name, const char *pattern, int n,
+                             int threads, const TimingStats *stats) {
+    fprintf(fp, "%s,%s,%d,%.6f,%d," MEASURE_CSV_FORMAT,
+            name, pattern, n, stats->median, threads, MEASURE_CSV_ARGS(*stats));
+    write_perf_columns(fp, n);
+    write_memory_columns(fp);
+    fprintf(fp, ",%s\n", cache_label());
+}
+
+// " [warm]" / " [cold]" after the case description in hygiene mode
+static void print_cache_pass(void) {
+    if (hygiene_enabled) {
+        printf(" [%s]", cache_label());
+    }
+}
 
 void benchmark_by_size(void (*sort_func)(int*, int), const char *name,
                        DataPattern pattern, AlgorithmComplexity complexity,
-                       bool include_large_inputs) {
+                       bool include_large_inputs, int threads) {
+    if (!pattern_selected(pattern)) {
+        return;
+    }
     FILE *fp = fopen("results/size_benchmark.csv", "a");
     if (fp == NULL) {
         printf("Error: Could not open results/size_benchmark.csv for writing\n");
         return;
     }
 
-    const int *primary_sizes = (complexity == COMPLEXITY_QUADRATIC) ? QUADRATIC_SIZES : DEFAULT_SIZES;
-    int primary_count = (complexity == COMPLEXITY_QUADRATIC) ? ARRAY_SIZE(QUADRATIC_SIZES)
-                                                             : ARRAY_SIZE(DEFAULT_SIZES);
-
-    const int *extra_sizes = (include_large_inputs && complexity != COMPLEXITY_QUADRATIC)
-                                 ? EXTENDED_SIZES
-                                 : NULL;
-    int extra_count = extra_sizes ? ARRAY_SIZE(EXTENDED_SIZES) : 0;
+    int sizes[MAX_SCHEDULE_SIZES];
+    int count = size_schedule(complexity, include_large_inputs, 0, sizes);
+    SweepFit fit;
+    sweep_fit_init(&fit, complexity_exponent(complexity));
+
+    for (int i = 0; i < count; i++) {
+        int n = sizes[i];
+        // Sizes only grow, so once one is out of budget the rest of the series is too
+        if (!fits_budget(projected_cost(&fit, n))) {
+            skip_rest_of_series(&fit, name, sizes, i, count);
+            break;
+        }
 
-    for (int series = 0; series < 2; series++) {
-        const int *sizes = series == 0 ? primary_sizes : extra_sizes;
-        int series_count = series == 0 ? primary_count : extra_count;
+        size_t bytes = (size_t)n * sizeof(int);
+        int *arr = (int*)bench_alloc(bytes);
+        int *input = (int*)bench_alloc(bytes);
 
-        if (sizes == NULL) {
+        if (arr == NULL || input == NULL) {
+            printf("Memory allocation failed for size %d\n", n);
+            bench_free(arr, bytes);
+            bench_free(input, bytes);
             continue;
         }
 
-        for (int i = 0; i < series_count; i++) {
-            int n = sizes[i];
-            int *arr = (int*)malloc(n * sizeof(int));
-            int *original = (int*)malloc(n * sizeof(int));
-
-            if (arr == NULL || original == NULL) {
-                printf("Memory allocation failed for size %d\n", n);
-                free(arr);
-                free(original);
-                continue;
-            }
-
-            generate_data(arr, n, pattern);
-            memcpy(original, arr, n * sizeof(int));  // Keep original for verification
+        generate_data(input, n, pattern);
+        Fingerprint fingerprint = fingerprint_keys(input, n, sizeof(int), benchmark_thread_count());
 
+        for (int pass = 0; pass < cache_pass_count(); pass++) {
+            set_cache_pass(pass);
             printf("  Testing %s with %d elements (%s)...", name, n, pattern_names[pattern]);
+            print_cache_pass();
             fflush(stdout);
 
-            double time = benchmark_sort(sort_func, arr, n);
+            SortTrial trial = {sort_func, arr, input, n};
+            TimingStats stats = measure_case(sort_trial, &trial);
 
-            // Verify sort correctness
-            if (!is_sorted(arr, n)) {
-                printf(" [FAIL - NOT SORTED]\n");
-            } else if (!verify_sort_result(arr, original, n, name)) {
-                printf(" [FAIL - WRONG RESULT]\n");
+            // Verify sort correctness (the input doubles as the full-verification reference)
+            const char *failure = check_sort_result(arr, n, fingerprint,
+                                                    full_verification ? input : NULL, name);
+            if (failure != NULL) {
+                printf("%s\n", failure);
             } else {
-                printf(" OK (%.4fs)\n", time);
+                print_timing(&stats);
+                if (pass == 0 && stats.runs > 0) {
+                    sweep_fit_add(&fit, n, stats.median);
+                }
             }
 
-            fprintf(fp, "%s,%s,%d,%.6f\n", name, pattern_names[pattern], n, time);
-
-            free(arr);
-            free(original);
+            write_timing_row(fp, name, pattern_names[pattern], n, threads, &stats);
         }
+        set_cache_pass(0);
+
+        bench_free(arr, bytes);
+        bench_free(input, bytes);
     }
 
+    if (pattern == RANDOM) {
+        algorithm_fit = fit;
+        algorithm_fit_name = name;
+    }
     fclose(fp);
 }
 
@@ -223,56 +795,823 @@ static int get_pattern_test_size(AlgorithmComplexity complexity, bool include_la
     return 100000; // fallback
 }
 
+/* ========== Auto Dispatch Tracking ========== */
+
+// Warm pattern results, kept so each sort_auto decision can be set against the pattern's winner
+#define MAX_PATTERN_RESULTS 256
+
+typedef struct {
+    const char *name;           // Registry name (a string literal)
+    DataPattern pattern;
+    int size;
+    double median;
+} PatternResult;
+
+static PatternResult pattern_results[MAX_PATTERN_RESULTS];
+static int pattern_result_count = 0;
+
+typedef struct {
+    DataPattern pattern;
+    int size;
+    double median;
+    SortAutoDecision decision;
+} AutoDispatch;
+
+static AutoDispatch auto_dispatches[8];
+static int auto_dispatch_count = 0;
+
+static void record_pattern_result(void (*sort_func)(int*, int), const char *name,
+                                  DataPattern pattern, int size, double median) {
+    if (pattern_result_count < MAX_PATTERN_RESULTS) {
+        pattern_results[pattern_result_count++] = (PatternResult){name, pattern, size, median};
+    }
+    if (sort_func == sort_auto && auto_dispatch_count < ARRAY_SIZE(auto_dispatches)) {
+        auto_dispatches[auto_dispatch_count++] =
+            (AutoDispatch){pattern, size, median, sort_auto_last_decision()};
+    }
+}
+
+// "    -> RadixSort (wide keys, shuffled; 499712 runs, range 1000000)"
+static void print_auto_decision(void) {
+    SortAutoDecision d = sort_auto_last_decision();
+    printf("    -> %s (%s; %d runs, range %lld", sort_auto_engine_name(d.engine), d.reason,
+           d.runs, d.range);
+    if (d.sample_size > 0) {
+        printf(", %d of %d sampled keys distinct", d.sample_distinct, d.sample_size);
+    }
+    printf(")\n");
+}
+
+/*
+ * Set every sort_auto decision against the fastest other engine measured on
+ * the same pattern and size, on screen and in results/auto_dispatch.csv.
+ */
+static void report_auto_dispatch(void) {
+    if (auto_dispatch_count == 0) {
+        return;
+    }
+    FILE *fp = fopen("results/auto_dispatch.csv", "w");
+    if (fp == NULL) {
+        printf("Error: Could not open results/auto_dispatch.csv for writing\n");
+        return;
+    }
+    fprintf(fp, "Pattern,Size,Engine,Reason,Runs,Range,SampleDistinct,SampleSize,Time,Winner,WinnerTime\n");
+
+    printf("\n=== AutoSort Dispatch vs Per-pattern Winner ===\n");
+    for (int i = 0; i < auto_dispatch_count; i++) {
+        const AutoDispatch *dispatch = &auto_dispatches[i];
+        const PatternResult *winner = NULL;
+        for (int r = 0; r < pattern_result_count; r++) {
+            const PatternResult *result = &pattern_results[r];
+            if (result->pattern == dispatch->pattern && result->size == dispatch->size &&
+                strcmp(result->name, "AutoSort") != 0 &&
+                (winner == NULL || result->median < winner->median)) {
+                winner = result;
+            }
+        }
+
+        const SortAutoDecision *d = &dispatch->decision;
+        const char *engine = sort_auto_engine_name(d->engine);
+        printf("  %-14s n=%-9d %-18s %.4fs", pattern_names[dispatch->pattern], dispatch->size,
+               engine, dispatch->median);
+        if (winner != NULL) {
+            printf("  winner %s %.4fs (%+.0f%%)\n", winner->name, winner->median,
+                   100.0 * (dispatch->median / winner->median - 1.0));
+        } else {
+            printf("  (no other engine ran at this size)\n");
+        }
+
+        fprintf(fp, "%s,%d,%s,\"%s\",%d,%lld,%d,%d,%.6f,%s,", pattern_names[dispatch->pattern],
+                dispatch->size, engine, d->reason, d->runs, d->range, d->sample_distinct,
+                d->sample_size, dispatch->median, winner != NULL ? winner->name : "");
+        if (winner != NULL) {
+            fprintf(fp, "%.6f", winner->median);
+        }
+        fprintf(fp, "\n");
+    }
+    fclose(fp);
+}
+
 void benchmark_by_pattern(void (*sort_func)(int*, int), const char *name,
                           AlgorithmComplexity complexity,
-                          bool include_large_inputs) {
+                          bool include_large_inputs, int threads) {
+    DataPattern patterns[] = {RANDOM, SORTED, REVERSE_SORTED, NEARLY_SORTED};
+    int selected = 0;
+    for (int i = 0; i < ARRAY_SIZE(patterns); i++) {
+        selected += pattern_selected(patterns[i]);
+    }
+    if (selected == 0) {
+        return;
+    }
+
+    // Projected from this algorithm's random-input size sweep when one just ran
+    SweepFit fit;
+    if (algorithm_fit_name != NULL && strcmp(algorithm_fit_name, name) == 0) {
+        fit = algorithm_fit;
+    } else {
+        sweep_fit_init(&fit, complexity_exponent(complexity));
+    }
+    int requested = clamp_to_size_range(get_pattern_test_size(complexity, include_large_inputs));
+    int size = affordable_size(&fit, requested, selected);
+
+    if (size == 0) {
+        if (fit.count == 0) {
+            printf("Skipping %s pattern runs at %d elements: time budget exhausted\n", name, requested);
+        } else {
+            printf("Skipping %s pattern runs at %d elements: projected %.1fs, %.1fs of time budget left\n",
+                   name, requested, selected * projected_cost(&fit, requested),
+                   fmax(sweep_planner_remaining(), 0.0));
+        }
+        for (int i = 0; i < selected; i++) {
+            sweep_planner_skip(projected_cost(&fit, requested));
+        }
+        return;
+    }
+
     FILE *fp = fopen("results/pattern_benchmark.csv", "a");
     if (fp == NULL) {
         printf("Error: Could not open results/pattern_benchmark.csv for writing\n");
         return;
     }
+    if (size < requested) {
+        printf("Testing %s with different patterns (size=%d, reduced from %d to fit the time budget):\n",
+               name, size, requested);
+    } else {
+        printf("Testing %s with different patterns (size=%d):\n", name, size);
+    }
 
-    DataPattern patterns[] = {RANDOM, SORTED, REVERSE_SORTED, NEARLY_SORTED};
+    size_t bytes = (size_t)size * sizeof(int);
+    for (int i = 0; i < ARRAY_SIZE(patterns); i++) {
+        if (!pattern_selected(patterns[i])) {
+            continue;
+        }
+        int *arr = (int*)bench_alloc(bytes);
+        int *input = (int*)bench_alloc(bytes);
+
+        if (arr == NULL || input == NULL) {
+            printf("Memory allocation failed\n");
+            bench_free(arr, bytes);
+            bench_free(input, bytes);
+            continue;
+        }
 
-    int size = get_pattern_test_size(complexity, include_large_inputs);
+        generate_data(input, size, patterns[i]);
+        Fingerprint fingerprint = fingerprint_keys(input, size, sizeof(int), benchmark_thread_count());
 
-    printf("Testing %s with different patterns (size=%d):\n", name, size);
+        for (int pass = 0; pass < cache_pass_count(); pass++) {
+            set_cache_pass(pass);
+            printf("  Pattern: %s...", pattern_names[i]);
+            print_cache_pass();
+            fflush(stdout);
 
-    for (int i = 0; i < 4; i++) {
-        int *arr = (int*)malloc(size * sizeof(int));
-        int *original = (int*)malloc(size * sizeof(int));
+            SortTrial trial = {sort_func, arr, input, size};
+            TimingStats stats = measure_case(sort_trial, &trial);
 
-        if (arr == NULL || original == NULL) {
-            printf("Memory allocation failed\n");
-            free(arr);
-            free(original);
+            // Verify sort correctness (the input doubles as the full-verification reference)
+            const char *failure = check_sort_result(arr, size, fingerprint,
+                                                    full_verification ? input : NULL, name);
+            if (failure != NULL) {
+                printf("%s\n", failure);
+            } else {
+                print_timing(&stats);
+                if (sort_func == sort_auto) {
+                    print_auto_decision();
+                }
+                if (pass == 0) {
+                    record_pattern_result(sort_func, name, patterns[i], size, stats.median);
+                }
+            }
+
+            write_timing_row(fp, name, pattern_names[i], size, threads, &stats);
+        }
+        set_cache_pass(0);
+
+        bench_free(arr, bytes);
+        bench_free(input, bytes);
+    }
+
+    fclose(fp);
+}
+
+/* ========== Typed Key Sweeps (int64, uint64, float, double) ========== */
+
+// Cap for the typed sweeps: 50M doubles need ~1.2 GB with the input copy and radix buffer
+#define TYPED_SWEEP_MAX_SIZE 50000000
+
+static const char *key_type_names[] = {"int64", "uint64", "float", "double"};
+
+static size_t key_type_size(KeyType type) {
+    switch (type) {
+        case KEY_INT64:  return sizeof(int64_t);
+        case KEY_UINT64: return sizeof(uint64_t);
+        case KEY_FLOAT:  return sizeof(float);
+        case KEY_DOUBLE: return sizeof(double);
+    }
+    return 0;
+}
+
+static void generate_typed_data(void *arr, int n, KeyType type, DataPattern pattern) {
+    switch (type) {
+        case KEY_INT64:  generate_data_i64((int64_t *)arr, n, pattern); break;
+        case KEY_UINT64: generate_data_u64((uint64_t *)arr, n, pattern); break;
+        case KEY_FLOAT:  generate_data_f32((float *)arr, n, pattern); break;
+        case KEY_DOUBLE: generate_data_f64((double *)arr, n, pattern); break;
+    }
+}
+
+static int compare_i64(const void *a, const void *b) {
+    int64_t lhs = *(const int64_t *)a;
+    int64_t rhs = *(const int64_t *)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t lhs = *(const uint64_t *)a;
+    uint64_t rhs = *(const uint64_t *)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+// -0 sorts before +0, matching the radix key order, so memcmp can verify
+static int compare_f32(const void *a, const void *b) {
+    float lhs = *(const float *)a;
+    float rhs = *(const float *)b;
+    if (lhs != rhs) {
+        return (lhs > rhs) - (lhs < rhs);
+    }
+    return (signbit(lhs) == 0) - (signbit(rhs) == 0);
+}
+
+static int compare_f64(const void *a, const void *b) {
+    double lhs = *(const double *)a;
+    double rhs = *(const double *)b;
+    if (lhs != rhs) {
+        return (lhs > rhs) - (lhs < rhs);
+    }
+    return (signbit(lhs) == 0) - (signbit(rhs) == 0);
+}
+
+static int (*const key_type_compare[])(const void *, const void *) = {
+    compare_i64, compare_u64, compare_f32, compare_f64
+};
+
+static void radix_sort_i64_wrapper(void *arr, int n) {
+    radix_sort_i64((int64_t *)arr, n);
+}
+
+static void radix_sort_u64_wrapper(void *arr, int n) {
+    radix_sort_u64((uint64_t *)arr, n);
+}
+
+static void radix_sort_f32_wrapper(void *arr, int n) {
+    radix_sort_f32((float *)arr, n);
+}
+
+static void radix_sort_f64_wrapper(void *arr, int n) {
+    radix_sort_f64((double *)arr, n);
+}
+
+typedef struct {
+    void (*sort_func)(void *, int);
+    void *arr;
+    const void *input;
+    int n;
+    size_t elem_size;
+} TypedSortTrial;
+
+static double typed_sort_trial(void *arg) {
+    TypedSortTrial *trial = (TypedSortTrial *)arg;
+    memcpy(trial->arr, trial->input, (size_t)trial->n * trial->elem_size);
+
+    struct timespec start, end;
+    timed_region_begin();
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    trial->sort_func(trial->arr, trial->n);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    timed_region_end();
+    return (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+void benchmark_typed_by_size(void (*sort_func)(void *, int), const char *name,
+                             KeyType type, DataPattern pattern,
+                             bool include_large_inputs) {
+    if (!pattern_selected(pattern)) {
+        return;
+    }
+    FILE *fp = fopen("results/size_benchmark.csv", "a");
+    if (fp == NULL) {
+        printf("Error: Could not open results/size_benchmark.csv for writing\n");
+        return;
+    }
+
+    size_t elem_size = key_type_size(type);
+
+    int sizes[MAX_SCHEDULE_SIZES];
+    int count = size_schedule(COMPLEXITY_LINEAR, include_large_inputs, TYPED_SWEEP_MAX_SIZE, sizes);
+    SweepFit fit;
+    sweep_fit_init(&fit, complexity_exponent(COMPLEXITY_LINEAR));
+
+    for (int i = 0; i < count; i++) {
+        int n = sizes[i];
+        if (!fits_budget(projected_cost(&fit, n))) {
+            skip_rest_of_series(&fit, name, sizes, i, count);
+            break;
+        }
+
+        size_t bytes = (size_t)n * elem_size;
+        void *arr = bench_alloc(bytes);
+        void *input = bench_alloc(bytes);
+
+        if (arr == NULL || input == NULL) {
+            printf("Memory allocation failed for size %d\n", n);
+            bench_free(arr, bytes);
+            bench_free(input, bytes);
             continue;
         }
 
-        generate_data(arr, size, patterns[i]);
-        memcpy(original, arr, size * sizeof(int));  // Keep original for verification
+        generate_typed_data(input, n, type, pattern);
+        Fingerprint fingerprint = fingerprint_keys(input, n, elem_size, benchmark_thread_count());
+
+        for (int pass = 0; pass < cache_pass_count(); pass++) {
+            set_cache_pass(pass);
+            printf("  Testing %s with %d %s keys (%s)...", name, n, key_type_names[type],
+                   pattern_names[pattern]);
+            print_cache_pass();
+            fflush(stdout);
+
+            TypedSortTrial trial = {sort_func, arr, input, n, elem_size};
+            TimingStats stats = measure_case(typed_sort_trial, &trial);
+
+            // Order under the matching comparator, keys by bit pattern, and optionally a qsort reference
+            int threads = benchmark_thread_count();
+            bool correct = find_unsorted(arr, n, elem_size, key_type_compare[type], threads) < 0 &&
+                           fingerprint_equal(fingerprint_keys(arr, n, elem_size, threads), fingerprint);
+            if (correct && full_verification && pass == cache_pass_count() - 1) {
+                // The reference is sorted in place; after the last pass the input is not needed again
+                qsort(input, (size_t)n, elem_size, key_type_compare[type]);
+                correct = memcmp(arr, input, bytes) == 0;
+            }
+            if (!correct) {
+                printf(" [FAIL - WRONG RESULT]\n");
+            } else {
+                print_timing(&stats);
+                if (pass == 0 && stats.runs > 0) {
+                    sweep_fit_add(&fit, n, stats.median);
+                }
+            }
+
+            write_timing_row(fp, name, pattern_names[pattern], n, 1, &stats);
+        }
+        set_cache_pass(0);
+
+        bench_free(arr, bytes);
+        bench_free(input, bytes);
+    }
+
+    fclose(fp);
+}
+
+/* ========== Record (key + payload) Sweeps ========== */
+
+// Cap for the record sweeps: 10M Record64s plus scratch and reference copies is ~500 MB
+#define RECORD_SWEEP_MAX_SIZE 10000000
+
+typedef enum {
+    RECORD_LAYOUT_AOS32,    // Record32: 4-byte key + 4-byte payload
+    RECORD_LAYOUT_SOA32,    // int32 key column + uint32 value column
+    RECORD_LAYOUT_AOS64     // Record64: 8-byte key + 8-byte payload
+} RecordLayout;
+
+typedef struct {
+    const char *name;
+    RecordLayout layout;
+    void (*sort_aos32)(Record32 *, int);
+    void (*sort_soa32)(int32_t *, uint32_t *, int);
+    void (*sort_aos64)(Record64 *, int);
+} RecordBenchmark;
+
+static const RecordBenchmark RECORD_BENCHMARKS[] = {
+    {"RadixRecord32", RECORD_LAYOUT_AOS32, record32_radix_sort, NULL, NULL},
+    {"RadixSoA",      RECORD_LAYOUT_SOA32, NULL, record_soa_radix_sort, NULL},
+    {"RadixRecord64", RECORD_LAYOUT_AOS64, NULL, NULL, record64_radix_sort},
+    {"MergeRecord32", RECORD_LAYOUT_AOS32, record32_merge_sort, NULL, NULL},
+    {"MergeSoA",      RECORD_LAYOUT_SOA32, NULL, record_soa_merge_sort, NULL},
+    {"MergeRecord64", RECORD_LAYOUT_AOS64, NULL, NULL, record64_merge_sort},
+    {"QuickRecord32", RECORD_LAYOUT_AOS32, record32_quick_sort, NULL, NULL},
+    {"QuickSoA",      RECORD_LAYOUT_SOA32, NULL, record_soa_quick_sort, NULL},
+    {"QuickRecord64", RECORD_LAYOUT_AOS64, NULL, NULL, record64_quick_sort},
+};
+
+// 64-bit keys keep the generated value in the high half and the row id in the low half
+static int64_t record64_key(int value, int row) {
+    return (int64_t)value * 4294967296LL + row;
+}
 
-        printf("  Pattern: %s...", pattern_names[i]);
+/*
+ * Build the layout from data (payload = row id), sort it, and check that keys
+ * are ascending and every payload still points at the row its key came from.
+ * Returns the sort time, or a negative value if the buffers cannot be allocated.
+ */
+static double run_record_benchmark(const RecordBenchmark *bench, const int *data, int n, bool *ok) {
+    double time = -1.0;
+    *ok = true;
+
+    if (bench->layout == RECORD_LAYOUT_AOS32) {
+        Record32 *records = (Record32 *)malloc((size_t)n * sizeof(Record32));
+        if (records == NULL) {
+            return time;
+        }
+        for (int i = 0; i < n; i++) {
+            records[i].key = data[i];
+            records[i].value = (uint32_t)i;
+        }
+        struct timespec start, end;
+        timed_region_begin();
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        bench->sort_aos32(records, n);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        timed_region_end();
+        time = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+        for (int i = 0; i < n && *ok; i++) {
+            *ok = records[i].key == data[records[i].value] &&
+                  (i == 0 || records[i - 1].key <= records[i].key);
+        }
+        free(records);
+    } else if (bench->layout == RECORD_LAYOUT_SOA32) {
+        int32_t *keys = (int32_t *)malloc((size_t)n * sizeof(int32_t));
+        uint32_t *values = (uint32_t *)malloc((size_t)n * sizeof(uint32_t));
+        if (keys == NULL || values == NULL) {
+            free(keys);
+            free(values);
+            return time;
+        }
+        for (int i = 0; i < n; i++) {
+            keys[i] = data[i];
+            values[i] = (uint32_t)i;
+        }
+        struct timespec start, end;
+        timed_region_begin();
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        bench->sort_soa32(keys, values, n);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        timed_region_end();
+        time = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+        for (int i = 0; i < n && *ok; i++) {
+            *ok = keys[i] == data[values[i]] && (i == 0 || keys[i - 1] <= keys[i]);
+        }
+        free(keys);
+        free(values);
+    } else {
+        Record64 *records = (Record64 *)malloc((size_t)n * sizeof(Record64));
+        if (records == NULL) {
+            return time;
+        }
+        for (int i = 0; i < n; i++) {
+            records[i].key = record64_key(data[i], i);
+            records[i].value = (uint64_t)i;
+        }
+        struct timespec start, end;
+        timed_region_begin();
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        bench->sort_aos64(records, n);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        timed_region_end();
+        time = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+        for (int i = 0; i < n && *ok; i++) {
+            *ok = records[i].value < (uint64_t)n &&
+                  records[i].key == record64_key(data[records[i].value], (int)records[i].value) &&
+                  (i == 0 || records[i - 1].key <= records[i].key);
+        }
+        free(records);
+    }
+
+    return time;
+}
+
+// Every trial rebuilds the layout; ok stays false once any trial is wrong
+typedef struct {
+    const RecordBenchmark *bench;
+    const int *data;
+    int n;
+    bool ok;
+} RecordTrial;
+
+static double record_trial(void *arg) {
+    RecordTrial *trial = (RecordTrial *)arg;
+    bool ok;
+    double time = run_record_benchmark(trial->bench, trial->data, trial->n, &ok);
+    trial->ok = trial->ok && ok;
+    return time;
+}
+
+void benchmark_record_sweep(bool include_large_inputs) {
+    if (!pattern_selected(RANDOM)) {
+        return;
+    }
+    FILE *fp = fopen("results/size_benchmark.csv", "a");
+    if (fp == NULL) {
+        printf("Error: Could not open results/size_benchmark.csv for writing\n");
+        return;
+    }
+
+    int sizes[MAX_SCHEDULE_SIZES];
+    int count = size_schedule(COMPLEXITY_LINEAR, include_large_inputs, RECORD_SWEEP_MAX_SIZE, sizes);
+    // One series per engine and layout; an engine that runs out of budget drops out
+    SweepFit fits[ARRAY_SIZE(RECORD_BENCHMARKS)];
+    bool active[ARRAY_SIZE(RECORD_BENCHMARKS)];
+    int active_count = 0;
+    for (int b = 0; b < ARRAY_SIZE(RECORD_BENCHMARKS); b++) {
+        sweep_fit_init(&fits[b], complexity_exponent(COMPLEXITY_LINEARITHMIC));
+        active[b] = algorithm_selected(RECORD_BENCHMARKS[b].name);
+        active_count += active[b];
+    }
+
+    for (int s = 0; s < count && active_count > 0; s++) {
+        int n = sizes[s];
+        size_t bytes = (size_t)n * sizeof(int);
+        int *data = (int *)bench_alloc(bytes);
+        if (data == NULL) {
+            printf("Memory allocation failed for size %d\n", n);
+            continue;
+        }
+        // Every layout sorts the same keys
+        generate_data(data, n, RANDOM);
+
+        for (int b = 0; b < ARRAY_SIZE(RECORD_BENCHMARKS); b++) {
+            const RecordBenchmark *bench = &RECORD_BENCHMARKS[b];
+            if (!active[b]) {
+                continue;
+            }
+            if (!fits_budget(projected_cost(&fits[b], n))) {
+                skip_rest_of_series(&fits[b], bench->name, sizes, s, count);
+                active[b] = false;
+                active_count--;
+                continue;
+            }
+            for (int pass = 0; pass < cache_pass_count(); pass++) {
+                set_cache_pass(pass);
+                printf("  Testing %s with %d elements (Random)...", bench->name, n);
+                print_cache_pass();
+                fflush(stdout);
+
+                RecordTrial trial = {bench, data, n, true};
+                TimingStats stats = measure_case(record_trial, &trial);
+                if (stats.runs == 0) {
+                    printf(" [SKIP - OUT OF MEMORY]\n");
+                    continue;
+                }
+                if (!trial.ok) {
+                    printf(" [FAIL - WRONG RESULT]\n");
+                } else {
+                    print_timing(&stats);
+                    if (pass == 0) {
+                        sweep_fit_add(&fits[b], n, stats.median);
+                    }
+                }
+                write_timing_row(fp, bench->name, pattern_names[RANDOM], n, 1, &stats);
+            }
+            set_cache_pass(0);
+        }
+        bench_free(data, bytes);
+    }
+
+    fclose(fp);
+}
+
+/* ========== External (out-of-core) Sort ========== */
+
+typedef struct {
+    ExternalKeyType type;
+    long long elements;
+    size_t budget;          // Well below the file size, so runs are spilled and merged
+    bool large;             // Only with include_large_inputs
+} ExternalBenchmark;
+
+static const ExternalBenchmark EXTERNAL_BENCHMARKS[] = {
+    {EXTERNAL_INT32, 16LL << 20, (size_t)16 << 20, false},    // 64 MiB file
+    {EXTERNAL_INT64, 16LL << 20, (size_t)16 << 20, false},    // 128 MiB file
+    {EXTERNAL_INT32, 256LL << 20, (size_t)64 << 20, true},    // 1 GiB file
+    {EXTERNAL_INT64, 768LL << 20, (size_t)256 << 20, true},   // 6 GiB file, beyond RAM on small boxes
+};
+
+/*
+ * Stream a file of keys once into fingerprint (the same scheme as the
+ * in-memory sweeps) and, if `sorted` is non-NULL, check ascending order.
+ * Returns false if the file cannot be read.
+ */
+static bool scan_key_file(const char *path, size_t key_size, Fingerprint *fingerprint, bool *sorted) {
+    enum { SCAN_CHUNK = 1 << 16 };
+    *fingerprint = (Fingerprint){0, 0, 0};
+    FILE *fp = fopen(path, "rb");
+    int64_t *chunk = (int64_t *)malloc(SCAN_CHUNK * sizeof(int64_t));
+    if (fp == NULL || chunk == NULL) {
+        if (fp != NULL) {
+            fclose(fp);
+        }
+        free(chunk);
+        return false;
+    }
+
+    int64_t previous = INT64_MIN;
+    size_t got;
+    if (sorted != NULL) {
+        *sorted = true;
+    }
+    while ((got = fread(chunk, key_size, SCAN_CHUNK, fp)) > 0) {
+        if (sorted != NULL) {
+            for (size_t i = 0; i < got; i++) {
+                int64_t key = key_size == sizeof(int32_t) ? ((const int32_t *)chunk)[i] : chunk[i];
+                if (key < previous) {
+                    *sorted = false;
+                }
+                previous = key;
+            }
+        }
+        fingerprint_update(fingerprint, chunk, (int)got, key_size);
+    }
+    bool ok = !ferror(fp);
+    fclose(fp);
+    free(chunk);
+    return ok;
+}
+
+void benchmark_external_sort(bool include_large_inputs) {
+    FILE *fp = fopen("results/external_benchmark.csv", "w");
+    if (fp == NULL) {
+        printf("Error: Could not open results/external_benchmark.csv for writing\n");
+        return;
+    }
+    fprintf(fp, "Algorithm,KeyType,Elements,Bytes,Budget,Runs,MergePasses,Time,GBps,Threads\n");
+
+    const char *input_path = "results/external_input.bin";
+    const char *output_path = "results/external_output.bin";
+    ExternalSortConfig config = {0, "results", benchmark_thread_count()};
+    // A single timed run per file, projected from the smaller files' times
+    SweepFit fit;
+    sweep_fit_init(&fit, 1.0);
+
+    for (int b = 0; b < ARRAY_SIZE(EXTERNAL_BENCHMARKS); b++) {
+        const ExternalBenchmark *bench = &EXTERNAL_BENCHMARKS[b];
+        if ((bench->large && !include_large_inputs) || !size_selected(bench->elements)) {
+            continue;
+        }
+        double projected = fit.count > 0 ? sweep_fit_predict(&fit, (int)bench->elements) : -1.0;
+        if (!fits_budget(projected)) {
+            if (projected < 0.0) {
+                printf("  Skipping ExternalMergeSort with %lld keys: time budget exhausted\n",
+                       bench->elements);
+            } else {
+                printf("  Skipping ExternalMergeSort with %lld keys: projected %.1fs, %.1fs of time budget left\n",
+                       bench->elements, projected, fmax(sweep_planner_remaining(), 0.0));
+            }
+            sweep_planner_skip(projected);
+            continue;
+        }
+        size_t key_size = external_key_size(bench->type);
+        const char *type_name = bench->type == EXTERNAL_INT32 ? "int32" : "int64";
+        double bytes = (double)bench->elements * (double)key_size;
+
+        printf("  Testing ExternalMergeSort with %lld %s keys (%.0f MiB file, %zu MiB budget)...",
+               bench->elements, type_name, bytes / (1 << 20), bench->budget >> 20);
         fflush(stdout);
 
-        double time = benchmark_sort(sort_func, arr, size);
+        if (generate_data_file(input_path, bench->elements, key_size, RANDOM) != 0) {
+            printf(" [SKIP - CANNOT WRITE INPUT]\n");
+            remove(input_path);
+            continue;
+        }
 
-        // Verify sort correctness
-        if (!is_sorted(arr, size)) {
-            printf(" [FAIL - NOT SORTED]\n");
-        } else if (!verify_sort_result(arr, original, size, name)) {
-            printf(" [FAIL - WRONG RESULT]\n");
+        config.memory_budget = bench->budget;
+        ExternalSortStats stats;
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        int status = external_sort_file(input_path, output_path, bench->type, &config, &stats);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double time = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+        sweep_planner_charge(time, time, 0.0);
+
+        if (status != 0) {
+            printf(" [SKIP - SORT FAILED]\n");
         } else {
-            printf(" OK (%.4fs)\n", time);
+            Fingerprint input_fingerprint, output_fingerprint;
+            bool sorted;
+            bool read_ok = scan_key_file(input_path, key_size, &input_fingerprint, NULL);
+            read_ok = scan_key_file(output_path, key_size, &output_fingerprint, &sorted) && read_ok;
+            double gbps = bytes / time / 1e9;
+            if (!read_ok || !sorted || !fingerprint_equal(input_fingerprint, output_fingerprint)) {
+                printf(" [FAIL - WRONG RESULT]\n");
+            } else {
+                printf(" OK (%.4fs, %.3f GB/s, %d runs, %d merge passes)\n",
+                       time, gbps, stats.runs, stats.merge_passes);
+                sweep_fit_add(&fit, (int)bench->elements, time);
+            }
+            fprintf(fp, "ExternalMergeSort,%s,%lld,%.0f,%zu,%d,%d,%.6f,%.6f,%d\n",
+                    type_name, bench->elements, bytes, bench->budget,
+                    stats.runs, stats.merge_passes, time, gbps, config.threads);
         }
+        remove(input_path);
+        remove(output_path);
+    }
+
+    fclose(fp);
+}
+
+/* ========== Algorithm Registry ========== */
+
+// The integer engines run_all_benchmarks sweeps, in order; variants follow their family's first entry
+typedef struct {
+    const char *name;               // Algorithm column in the CSVs (and --algorithms)
+    void (*sort_func)(int*, int);
+    AlgorithmComplexity complexity;
+    bool parallel;                  // Runs on the thread pool (Threads column gets its size)
+    bool sorted_sweep;              // Also sweep sizes on sorted input (adaptive best case)
+    bool variant;                   // Sub-sweep of the preceding family
+    const char *title;              // Family heading, or the variant's description
+} BenchmarkAlgorithm;
+
+static const BenchmarkAlgorithm BENCHMARK_ALGORITHMS[] = {
+    {"SelectionSort", selection_sort, COMPLEXITY_QUADRATIC, false, false, false, "Selection Sort"},
+    {"BubbleSort", bubble_sort, COMPLEXITY_QUADRATIC, false, true, false, "Bubble Sort"},
+    {"InsertionSort", insertion_sort, COMPLEXITY_QUADRATIC, false, true, false, "Insertion Sort"},
+    {"MergeSort", merge_sort, COMPLEXITY_LINEARITHMIC, false, false, false, "Merge Sort"},
+    {"MergeSortBottomUp", merge_sort_bottom_up, COMPLEXITY_LINEARITHMIC, false, false, true,
+     "Bottom-up (single scratch buffer) sweep"},
+    {"ParallelMergeSort", parallel_merge_sort_wrapper, COMPLEXITY_LINEARITHMIC, true, false, false,
+     "Parallel Merge Sort"},
+    {"QuickSort", quick_sort, COMPLEXITY_LINEARITHMIC, false, false, false, "Quick Sort"},
+    {"BlockQuickSort", block_quick_sort_wrapper, COMPLEXITY_LINEARITHMIC, false, false, true,
+     "Branchless block partition sweep"},
+    {"ParallelQuickSort", parallel_quick_sort_wrapper, COMPLEXITY_LINEARITHMIC, true, false, false,
+     "Parallel Quick Sort"},
+    {"ParallelSampleSort", parallel_sample_sort_wrapper, COMPLEXITY_LINEARITHMIC, true, false, false,
+     "Parallel Sample Sort"},
+    {"HeapSort", heap_sort, COMPLEXITY_LINEARITHMIC, false, false, false, "Heap Sort"},
+    {"HeapSort4ary", heap_sort_4ary_wrapper, COMPLEXITY_LINEARITHMIC, false, false, true,
+     "4-ary bottom-up heap sweep"},
+    {"HeapSort8ary", heap_sort_8ary_wrapper, COMPLEXITY_LINEARITHMIC, false, false, true,
+     "8-ary bottom-up heap sweep"},
+    {"IntroSort", intro_sort, COMPLEXITY_LINEARITHMIC, false, false, false, "Intro Sort (pattern-defeating)"},
+    {"ShellSort", shell_sort, COMPLEXITY_LINEARITHMIC, false, false, false, "Shell Sort"},
+    {"ShellSortCiura", shell_sort_ciura_wrapper, COMPLEXITY_LINEARITHMIC, false, false, true,
+     "Ciura gap sequence"},
+    {"ShellSortTokuda", shell_sort_tokuda_wrapper, COMPLEXITY_LINEARITHMIC, false, false, true,
+     "Tokuda gap sequence"},
+    {"ShellSortSedgewick", shell_sort_sedgewick_wrapper, COMPLEXITY_LINEARITHMIC, false, false, true,
+     "Sedgewick gap sequence"},
+    {"ShellSortPratt", shell_sort_pratt_wrapper, COMPLEXITY_LINEARITHMIC, false, false, true,
+     "Pratt gap sequence"},
+    {"CountingSort", counting_sort_wrapper, COMPLEXITY_LINEAR, false, false, false, "Counting Sort"},
+    {"CountingSortRange", counting_sort_range_wrapper, COMPLEXITY_LINEAR, false, false, true,
+     "Range-compacted (min..max) sweep"},
+    {"ParallelCountingSort", parallel_counting_sort_wrapper, COMPLEXITY_LINEAR, true, false, false,
+     "Parallel Counting Sort"},
+    {"RadixSort", radix_sort, COMPLEXITY_LINEAR, false, false, false, "Radix Sort"},
+    {"RadixSort11", radix_sort_11bit_wrapper, COMPLEXITY_LINEAR, false, false, true, "11-bit digit sweep"},
+    {"RadixSort16", radix_sort_16bit_wrapper, COMPLEXITY_LINEAR, false, false, true, "16-bit digit sweep"},
+    {"ParallelRadixSort", parallel_radix_sort_wrapper, COMPLEXITY_LINEAR, true, false, false,
+     "Parallel Radix Sort"},
+    {"BucketSort", bucket_sort, COMPLEXITY_LINEAR, false, false, false, "Bucket Sort"},
+    {"AutoSort", sort_auto, COMPLEXITY_LINEAR, false, false, false, "Auto Sort (input-aware dispatch)"},
+};
 
-        fprintf(fp, "%s,%s,%d,%.6f\n", name, pattern_names[i], size, time);
+// Typed-key engines (one step), record layouts (one step) and the external sort follow the registry
+#define TYPED_STEPS 3
+
+static const struct {
+    void (*sort_func)(void *, int);
+    const char *name;
+    KeyType type;
+} TYPED_ALGORITHMS[] = {
+    {radix_sort_i64_wrapper, "RadixSortI64", KEY_INT64},
+    {radix_sort_u64_wrapper, "RadixSortU64", KEY_UINT64},
+    {radix_sort_f32_wrapper, "RadixSortF32", KEY_FLOAT},
+    {radix_sort_f64_wrapper, "RadixSortF64", KEY_DOUBLE},
+};
 
-        free(arr);
-        free(original);
+static const char *complexity_section[] = {
+    "O(n^2) Algorithms",
+    "O(n log n) Algorithms",
+    "O(n) Algorithms"
+};
+
+static bool any_record_selected(void) {
+    for (int b = 0; b < ARRAY_SIZE(RECORD_BENCHMARKS); b++) {
+        if (algorithm_selected(RECORD_BENCHMARKS[b].name)) {
+            return true;
+        }
     }
+    return false;
+}
 
-    fclose(fp);
+static void run_registered_algorithm(const BenchmarkAlgorithm *algo, bool include_large_inputs) {
+    int threads = algo->parallel ? benchmark_thread_count() : 1;
+    sweep_planner_begin_algorithm();
+    benchmark_by_size(algo->sort_func, algo->name, RANDOM, algo->complexity, include_large_inputs, threads);
+    if (algo->sorted_sweep && pattern_selected(SORTED)) {
+        printf("  -> Best-case (sorted input) sweep\n");
+        benchmark_by_size(algo->sort_func, algo->name, SORTED, algo->complexity, include_large_inputs, threads);
+    }
+    benchmark_by_pattern(algo->sort_func, algo->name, algo->complexity, include_large_inputs, threads);
+    sweep_planner_end_algorithm();
 }
 
 void run_all_benchmarks(bool include_large_inputs) {
@@ -282,7 +1621,7 @@ void run_all_benchmarks(bool include_large_inputs) {
         printf("Error: Could not initialize results/size_benchmark.csv\n");
         return;
     }
-    fprintf(fp1, "Algorithm,Pattern,Size,Time\n");
+    fprintf(fp1, "Algorithm,Pattern,Size,Time,Threads," MEASURE_CSV_HEADER "," PERF_CSV_HEADER "," MEMORY_CSV_HEADER ",Cache\n");
     fclose(fp1);
 
     FILE *fp2 = fopen("results/pattern_benchmark.csv", "w");
@@ -290,12 +1629,34 @@ void run_all_benchmarks(bool include_large_inputs) {
         printf("Error: Could not initialize results/pattern_benchmark.csv\n");
         return;
     }
-    fprintf(fp2, "Algorithm,Pattern,Size,Time\n");
+    fprintf(fp2, "Algorithm,Pattern,Size,Time,Threads," MEASURE_CSV_HEADER "," PERF_CSV_HEADER "," MEMORY_CSV_HEADER ",Cache\n");
     fclose(fp2);
 
+    pattern_result_count = 0;
+    auto_dispatch_count = 0;
+
+    int steps = TYPED_STEPS;
+    for (int a = 0; a < ARRAY_SIZE(BENCHMARK_ALGORITHMS); a++) {
+        steps += !BENCHMARK_ALGORITHMS[a].variant;
+    }
+
     printf("Starting comprehensive benchmark...\n\n");
     printf("Testing conditions:\n");
-    printf("- Patterns: Random, Sorted, Reverse Sorted, Nearly Sorted\n");
+    printf("- Patterns: %s\n", pattern_filter != NULL ? pattern_filter
+                                                     : "Random, Sorted, Reverse Sorted, Nearly Sorted");
+    if (algorithm_filter != NULL) {
+        printf("- Algorithms: %s\n", algorithm_filter);
+    }
+    printf("- Input seed: %llu (--seed to change)\n", (unsigned long long)data_generator_seed());
+    const MeasureConfig *measure = measure_config();
+    if (measure->target_ci > 0.0) {
+        printf("- Trials: %d warmup, %d-%d timed until the 95%% CI is within +/-%.1f%% of the mean, %.1fs per case\n",
+               measure->warmup, measure->repetitions, measure->max_repetitions,
+               100.0 * measure->target_ci, measure->time_budget);
+    } else {
+        printf("- Trials: %d warmup, %d timed, %.1fs per case\n",
+               measure->warmup, measure->repetitions, measure->time_budget);
+    }
     printf("- Baseline sizes: up to %d elements\n",
         DEFAULT_SIZES[ARRAY_SIZE(DEFAULT_SIZES) - 1]);
     if (include_large_inputs) {
@@ -304,108 +1665,189 @@ void run_all_benchmarks(bool include_large_inputs) {
     } else {
      printf("- Extended sizes disabled (efficient algorithms limited to baseline)\n");
     }
+    if (max_size_filter > 0) {
+        printf("- Size filter: %lld to %lld elements\n", min_size_filter, max_size_filter);
+    } else if (min_size_filter > 0) {
+        printf("- Size filter: at least %lld elements\n", min_size_filter);
+    }
+    if (sweep_planner_active()) {
+        printf("- Time budget:");
+        if (sweep_planner_algorithm_budget() > 0.0) {
+            printf(" %gs per algorithm", sweep_planner_algorithm_budget());
+        }
+        if (sweep_planner_total_budget() > 0.0) {
+            printf("%s %gs in total", sweep_planner_algorithm_budget() > 0.0 ? "," : "",
+                   sweep_planner_total_budget());
+        }
+        printf(" (sizes projected past it are skipped)\n");
+    }
     printf("\n");
 
-    // O(n^2) algorithms - test with smaller sizes only
-    printf("=== Testing O(n^2) Algorithms ===\n");
-    printf("(Limited to %d elements max)\n\n",
-        QUADRATIC_SIZES[ARRAY_SIZE(QUADRATIC_SIZES) - 1]);
-
-    printf("[1/10] Selection Sort\n");
-    benchmark_by_size(selection_sort, "SelectionSort", RANDOM, COMPLEXITY_QUADRATIC, include_large_inputs);
-    benchmark_by_pattern(selection_sort, "SelectionSort", COMPLEXITY_QUADRATIC, include_large_inputs);
-
-    printf("\n[2/10] Bubble Sort\n");
-    benchmark_by_size(bubble_sort, "BubbleSort", RANDOM, COMPLEXITY_QUADRATIC, include_large_inputs);
-    printf("  -> Best-case (sorted input) sweep\n");
-    benchmark_by_size(bubble_sort, "BubbleSort", SORTED, COMPLEXITY_QUADRATIC, include_large_inputs);
-    benchmark_by_pattern(bubble_sort, "BubbleSort", COMPLEXITY_QUADRATIC, include_large_inputs);
-
-    printf("\n[3/10] Insertion Sort\n");
-    benchmark_by_size(insertion_sort, "InsertionSort", RANDOM, COMPLEXITY_QUADRATIC, include_large_inputs);
-    printf("  -> Best-case (sorted input) sweep\n");
-    benchmark_by_size(insertion_sort, "InsertionSort", SORTED, COMPLEXITY_QUADRATIC, include_large_inputs);
-    benchmark_by_pattern(insertion_sort, "InsertionSort", COMPLEXITY_QUADRATIC, include_large_inputs);
-
-    // O(n log n) algorithms - test with all sizes
-    printf("\n=== Testing O(n log n) Algorithms ===\n");
-    printf("(Default limit %d; extended limit %d when enabled)\n\n",
-        DEFAULT_SIZES[ARRAY_SIZE(DEFAULT_SIZES) - 1],
-        EXTENDED_SIZES[ARRAY_SIZE(EXTENDED_SIZES) - 1]);
-
-    printf("[4/10] Merge Sort\n");
-    benchmark_by_size(merge_sort, "MergeSort", RANDOM, COMPLEXITY_LINEARITHMIC, include_large_inputs);
-    benchmark_by_pattern(merge_sort, "MergeSort", COMPLEXITY_LINEARITHMIC, include_large_inputs);
+    int step = 0;
+    int section = -1;
+    const char *family = NULL;
+    for (int a = 0; a < ARRAY_SIZE(BENCHMARK_ALGORITHMS); a++) {
+        const BenchmarkAlgorithm *algo = &BENCHMARK_ALGORITHMS[a];
+        if (!algo->variant) {
+            step++;
+            family = algo->title;
+        }
+        if (!algorithm_selected(algo->name)) {
+            continue;
+        }
 
-    printf("\n[5/10] Quick Sort\n");
-    benchmark_by_size(quick_sort, "QuickSort", RANDOM, COMPLEXITY_LINEARITHMIC, include_large_inputs);
-    benchmark_by_pattern(quick_sort, "QuickSort", COMPLEXITY_LINEARITHMIC, include_large_inputs);
+        if ((int)algo->complexity != section) {
+            printf("%s=== Testing %s ===\n", section >= 0 ? "\n" : "", complexity_section[algo->complexity]);
+            if (algo->complexity == COMPLEXITY_QUADRATIC) {
+                printf("(Limited to %d elements max)\n",
+                    QUADRATIC_SIZES[ARRAY_SIZE(QUADRATIC_SIZES) - 1]);
+            } else {
+                printf("(Default limit %d; extended limit %d when enabled)\n",
+                    DEFAULT_SIZES[ARRAY_SIZE(DEFAULT_SIZES) - 1],
+                    EXTENDED_SIZES[ARRAY_SIZE(EXTENDED_SIZES) - 1]);
+            }
+            section = (int)algo->complexity;
+        }
+        if (family != NULL) {
+            if (algo->parallel && !algo->variant) {
+                printf("\n[%d/%d] %s (%d threads)\n", step, steps, family, benchmark_thread_count());
+            } else {
+                printf("\n[%d/%d] %s\n", step, steps, family);
+            }
+            family = NULL;
+        }
+        if (algo->variant) {
+            printf("  -> %s\n", algo->title);
+        }
+        run_registered_algorithm(algo, include_large_inputs);
+    }
 
-    printf("\n[6/10] Heap Sort\n");
-    benchmark_by_size(heap_sort, "HeapSort", RANDOM, COMPLEXITY_LINEARITHMIC, include_large_inputs);
-    benchmark_by_pattern(heap_sort, "HeapSort", COMPLEXITY_LINEARITHMIC, include_large_inputs);
+    bool typed_selected = false;
+    for (int t = 0; t < ARRAY_SIZE(TYPED_ALGORITHMS); t++) {
+        typed_selected = typed_selected || algorithm_selected(TYPED_ALGORITHMS[t].name);
+    }
+    if (typed_selected || any_record_selected()) {
+        // Wider and floating-point keys through the typed radix engines
+        printf("\n=== Testing Typed Keys and Record Sorts ===\n");
+    }
+    if (typed_selected) {
+        printf("\n[%d/%d] Typed Radix Sort (int64, uint64, float, double keys)\n", steps - 2, steps);
+        for (int t = 0; t < ARRAY_SIZE(TYPED_ALGORITHMS); t++) {
+            if (algorithm_selected(TYPED_ALGORITHMS[t].name)) {
+                sweep_planner_begin_algorithm();
+                benchmark_typed_by_size(TYPED_ALGORITHMS[t].sort_func, TYPED_ALGORITHMS[t].name,
+                                        TYPED_ALGORITHMS[t].type, RANDOM, include_large_inputs);
+                sweep_planner_end_algorithm();
+            }
+        }
+    }
 
-    // Special algorithms
-    printf("\n=== Testing Special Algorithms ===\n\n");
+    if (any_record_selected()) {
+        // Key + payload records: cost of dragging the payload through each engine
+        printf("\n[%d/%d] Record Sorts (payload-width sweep: 8B AoS, 4+4B SoA, 16B AoS)\n", steps - 1, steps);
+        sweep_planner_begin_algorithm();
+        benchmark_record_sweep(include_large_inputs);
+        sweep_planner_end_algorithm();
+    }
 
-    printf("[7/10] Shell Sort\n");
-    benchmark_by_size(shell_sort, "ShellSort", RANDOM, COMPLEXITY_LINEARITHMIC, include_large_inputs);
-    benchmark_by_pattern(shell_sort, "ShellSort", COMPLEXITY_LINEARITHMIC, include_large_inputs);
+    if (algorithm_selected("ExternalMergeSort")) {
+        // Files larger than the memory budget: runs spilled to disk, then merged
+        printf("\n=== Testing External Sort ===\n\n");
 
-    printf("\n[8/10] Counting Sort\n");
-    benchmark_by_size(counting_sort_wrapper, "CountingSort", RANDOM, COMPLEXITY_LINEAR, include_large_inputs);
-    benchmark_by_pattern(counting_sort_wrapper, "CountingSort", COMPLEXITY_LINEAR, include_large_inputs);
+        printf("[%d/%d] External Merge Sort (%d threads for run sorting)\n", steps, steps,
+               benchmark_thread_count());
+        sweep_planner_begin_algorithm();
+        benchmark_external_sort(include_large_inputs);
+        sweep_planner_end_algorithm();
+    }
 
-    printf("\n[9/10] Radix Sort\n");
-    benchmark_by_size(radix_sort, "RadixSort", RANDOM, COMPLEXITY_LINEAR, include_large_inputs);
-    benchmark_by_pattern(radix_sort, "RadixSort", COMPLEXITY_LINEAR, include_large_inputs);
+    report_auto_dispatch();
 
-    printf("\n[10/10] Bucket Sort\n");
-    benchmark_by_size(bucket_sort, "BucketSort", RANDOM, COMPLEXITY_LINEAR, include_large_inputs);
-    benchmark_by_pattern(bucket_sort, "BucketSort", COMPLEXITY_LINEAR, include_large_inputs);
+    if (sweep_planner_active()) {
+        SweepPlannerTotals totals = sweep_planner_totals();
+        printf("\nTime budget: %.1fs spent, %d cases skipped (%d projected at %.0fs",
+               totals.spent, totals.skipped_cases, totals.skipped_cases - totals.unprojected_cases,
+               totals.skipped_seconds);
+        if (totals.unprojected_cases > 0) {
+            printf(", %d after the budget was exhausted", totals.unprojected_cases);
+        }
+        printf("), %.1fs of saved time spent on extra trials\n", totals.reserve_spent);
+    }
 
     printf("\n=== All Benchmarks Completed ===\n");
 }
 
 void run_stats_benchmark(void) {
-    printf("=== Bubble Sort Statistics Benchmark ===\n\n");
+    printf("=== Operation Count Benchmark ===\n\n");
+
+    if (!sort_stats_enabled()) {
+        printf("Operation counters are compiled out of this binary.\n");
+        printf("Run ./bin/benchmark_instrumented --stats-only instead.\n");
+        return;
+    }
 
     FILE *fp = fopen("results/stats_benchmark.csv", "w");
     if (fp == NULL) {
         printf("Error: Could not open results/stats_benchmark.csv for writing\n");
         return;
     }
-    fprintf(fp, "Algorithm,Pattern,Size,Time,Comparisons,Swaps\n");
-
-    const char *pattern_names[] = {"Random", "Sorted", "ReverseSorted", "NearlySorted"};
+    fprintf(fp, "Algorithm,Pattern,Size,Time,Comparisons,Swaps,Moves,Reads,Writes,AuxBytes\n");
+
+    static const struct {
+        void (*sort_func)(int*, int);
+        const char *name;
+    } algorithms[] = {
+        {selection_sort, "SelectionSort"},
+        {bubble_sort, "BubbleSort"},
+        {insertion_sort, "InsertionSort"},
+        {merge_sort, "MergeSort"},
+        {quick_sort, "QuickSort"},
+        {heap_sort, "HeapSort"},
+        {shell_sort, "ShellSort"},
+        {counting_sort_wrapper, "CountingSort"},
+        {radix_sort, "RadixSort"},
+        {bucket_sort, "BucketSort"}
+    };
     DataPattern patterns[] = {RANDOM, SORTED, REVERSE_SORTED, NEARLY_SORTED};
     int sizes[] = {100, 1000, 5000, 10000, 20000, 50000};
-    int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
-
-    for (int p = 0; p < 4; p++) {
-        printf("Pattern: %s\n", pattern_names[p]);
-        for (int s = 0; s < num_sizes; s++) {
-            int size = sizes[s];
-            int *arr = (int*)malloc(size * sizeof(int));
-            if (arr == NULL) {
-                printf("  Memory allocation failed for size %d\n", size);
-                continue;
-            }
-
-            generate_data(arr, size, patterns[p]);
-            BenchmarkResult result = benchmark_sort_stats(bubble_sort_stats, arr, size);
 
-            printf("  n=%6d: time=%.6fs, comparisons=%llu, swaps=%llu\n",
-                   size, result.time_sec,
-                   (unsigned long long)result.stats.comparisons,
-                   (unsigned long long)result.stats.swaps);
+    for (int a = 0; a < ARRAY_SIZE(algorithms); a++) {
+        printf("%s\n", algorithms[a].name);
+        for (int p = 0; p < ARRAY_SIZE(patterns); p++) {
+            for (int s = 0; s < ARRAY_SIZE(sizes); s++) {
+                int size = sizes[s];
+                int *arr = (int*)malloc(size * sizeof(int));
+                if (arr == NULL) {
+                    printf("  Memory allocation failed for size %d\n", size);
+                    continue;
+                }
+
+                generate_data(arr, size, patterns[p]);
+                Fingerprint fingerprint = fingerprint_keys(arr, size, sizeof(int), 1);
+                BenchmarkResult result = benchmark_sort_stats(algorithms[a].sort_func, arr, size);
+                const SortStats *stats = &result.stats;
+
+                const char *failure = check_sort_result(arr, size, fingerprint, NULL,
+                                                        algorithms[a].name);
+                printf("  %-13s n=%6d: comparisons=%llu, swaps=%llu, moves=%llu, aux=%lluB%s\n",
+                       pattern_names[patterns[p]], size,
+                       (unsigned long long)stats->comparisons,
+                       (unsigned long long)stats->swaps,
+                       (unsigned long long)stats->moves,
+                       (unsigned long long)stats->aux_bytes,
+                       failure != NULL ? failure : "");
+
+                fprintf(fp, "%s,%s,%d,%.9f,%llu,%llu,%llu,%llu,%llu,%llu\n",
+                        algorithms[a].name, pattern_names[patterns[p]], size, result.time_sec,
+                        (unsigned long long)stats->comparisons,
+                        (unsigned long long)stats->swaps,
+                        (unsigned long long)stats->moves,
+                        (unsigned long long)stats->reads,
+                        (unsigned long long)stats->writes,
+                        (unsigned long long)stats->aux_bytes);
 
-            fprintf(fp, "BubbleSort,%s,%d,%.9f,%llu,%llu\n",
-                    pattern_names[p], size, result.time_sec,
-                    (unsigned long long)result.stats.comparisons,
-                    (unsigned long long)result.stats.swaps);
-
-            free(arr);
+                free(arr);
+            }
         }
         printf("\n");
     }
@@ -1,29 +1,186 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
-#include <time.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "../include/data_generator.h"
+#include "../include/thread_pool.h"
+
+/* ========== Seed, threads and cache settings ========== */
+
+static uint64_t generator_seed = DATA_GENERATOR_DEFAULT_SEED;
+static int generator_threads = 0;
+static char generator_cache_dir[256] = "";   // Empty: cache disabled
+
+void data_generator_set_seed(uint64_t seed) {
+    generator_seed = seed;
+}
+
+uint64_t data_generator_seed(void) {
+    return generator_seed;
+}
+
+void data_generator_set_threads(int threads) {
+    generator_threads = threads > 0 ? threads : 0;
+}
+
+void data_generator_set_cache_dir(const char *dir) {
+    if (dir == NULL) {
+        generator_cache_dir[0] = '\0';
+    } else {
+        snprintf(generator_cache_dir, sizeof(generator_cache_dir), "%s", dir);
+    }
+}
+
+/* ========== Counter-based random numbers ========== */
+
+/*
+ * Value i of a stream is a pure function of (seed, stream, i): the SplitMix64
+ * finalizer applied to a Weyl sequence. Any element can be produced
+ * independently, so chunks can be filled by any thread in any order and the
+ * output never depends on the thread count.
+ */
+enum {
+    STREAM_INT,
+    STREAM_SWAPS,
+    STREAM_I64,
+    STREAM_U64,
+    STREAM_F32,
+    STREAM_F64
+};
+
+static inline uint64_t mix64(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+static inline uint64_t stream_key(int stream) {
+    return mix64(generator_seed ^ mix64((uint64_t)stream + 1));
+}
+
+static inline uint64_t counter_u64(uint64_t key, uint64_t index) {
+    return mix64(key + (index + 1) * 0x9e3779b97f4a7c15ULL);
+}
+
+// Uniform in [0, bound) (multiply-high, no modulo bias worth measuring at these bounds)
+static inline uint32_t counter_bounded(uint64_t key, uint64_t index, uint32_t bound) {
+    return (uint32_t)(((counter_u64(key, index) >> 32) * bound) >> 32);
+}
+
+// Uniform in [0, 1) with 53 bits of precision
+static inline double counter_unit(uint64_t key, uint64_t index) {
+    return (double)(counter_u64(key, index) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Values range from 0 to 999,999, as with the original rand() % 1000000
+static inline int random_int_at(uint64_t key, uint64_t index) {
+    return (int)counter_bounded(key, index, 1000000);
+}
+
+/* ========== Parallel fill ========== */
+
+// Elements per task; fixed, so chunk boundaries do not depend on the thread count either
+#define GENERATE_CHUNK (1 << 16)
+// Below this size a thread pool costs more than it saves
+#define GENERATE_PARALLEL_CUTOFF (1 << 20)
+
+typedef struct FillContext FillContext;
+typedef void (*FillRangeFn)(const FillContext *ctx, int begin, int end);
+
+struct FillContext {
+    void *arr;
+    int n;
+    DataPattern pattern;
+    uint64_t key;
+    FillRangeFn fill;
+};
+
+static void fill_task(ThreadPool *pool, void *arg, int chunk, int unused) {
+    (void)pool;
+    (void)unused;
+    const FillContext *ctx = (const FillContext *)arg;
+    int begin = chunk * GENERATE_CHUNK;
+    int end = ctx->n - begin < GENERATE_CHUNK ? ctx->n : begin + GENERATE_CHUNK;
+    ctx->fill(ctx, begin, end);
+}
+
+static void fill_parallel(FillContext *ctx) {
+    int threads = generator_threads > 0 ? generator_threads : thread_pool_default_threads();
+    ThreadPool *pool = NULL;
+    if (threads > 1 && ctx->n >= GENERATE_PARALLEL_CUTOFF) {
+        pool = thread_pool_create(threads);
+    }
+    if (pool == NULL) {
+        ctx->fill(ctx, 0, ctx->n);
+        return;
+    }
+    thread_pool_parallel_for(pool, (ctx->n + GENERATE_CHUNK - 1) / GENERATE_CHUNK, fill_task, ctx);
+    thread_pool_destroy(pool);
+}
+
+// Swap s exchanges two positions drawn from the swap stream; applied in order, so serial
+#define APPLY_SWAPS(type, arr, n, swaps)                                      \
+    do {                                                                      \
+        uint64_t swap_key = stream_key(STREAM_SWAPS);                         \
+        for (int s = 0; s < (swaps); s++) {                                   \
+            uint32_t idx1 = counter_bounded(swap_key, 2 * (uint64_t)s, (uint32_t)(n));     \
+            uint32_t idx2 = counter_bounded(swap_key, 2 * (uint64_t)s + 1, (uint32_t)(n)); \
+            type temp = (arr)[idx1];                                          \
+            (arr)[idx1] = (arr)[idx2];                                        \
+            (arr)[idx2] = temp;                                               \
+        }                                                                     \
+    } while (0)
+
+/* ========== int patterns ========== */
+
+static void fill_int_range(const FillContext *ctx, int begin, int end) {
+    int *arr = (int *)ctx->arr;
+    switch (ctx->pattern) {
+        case RANDOM:
+            for (int i = begin; i < end; i++) {
+                arr[i] = random_int_at(ctx->key, (uint64_t)i);
+            }
+            break;
+        case SORTED:
+        case NEARLY_SORTED:
+            for (int i = begin; i < end; i++) {
+                arr[i] = i;
+            }
+            break;
+        case REVERSE_SORTED:
+            for (int i = begin; i < end; i++) {
+                arr[i] = ctx->n - i;
+            }
+            break;
+    }
+}
+
+static void fill_int(int *arr, int n, DataPattern pattern) {
+    FillContext ctx = {arr, n, pattern, stream_key(STREAM_INT), fill_int_range};
+    fill_parallel(&ctx);
+}
 
 void generate_random(int *arr, int n) {
     // Generate random integers from 0 to 999,999
-    for (int i = 0; i < n; i++) {
-        arr[i] = rand() % 1000000;
-    }
+    fill_int(arr, n, RANDOM);
 }
 
 void generate_sorted(int *arr, int n) {
     // Generate ascending sequence
     // Best case for: Insertion Sort, Bubble Sort (with optimization)
-    for (int i = 0; i < n; i++) {
-        arr[i] = i;
-    }
+    fill_int(arr, n, SORTED);
 }
 
 void generate_reverse_sorted(int *arr, int n) {
     // Generate descending sequence
     // Worst case for: Quick Sort (with bad pivot selection)
     // Worst case for: Insertion Sort, Bubble Sort
-    for (int i = 0; i < n; i++) {
-        arr[i] = n - i;
-    }
+    fill_int(arr, n, REVERSE_SORTED);
 }
 
 void generate_nearly_sorted(int *arr, int n, int swaps) {
@@ -32,23 +189,94 @@ void generate_nearly_sorted(int *arr, int n, int swaps) {
 
     // Perform random swaps (default: 5% of array size)
     // Tests adaptability to partially sorted data
-    for (int i = 0; i < swaps; i++) {
-        int idx1 = rand() % n;
-        int idx2 = rand() % n;
+    APPLY_SWAPS(int, arr, n, swaps);
+}
+
+/* ========== Dataset cache ========== */
+
+/*
+ * Generated int arrays of DATA_CACHE_MIN_SIZE or more elements are stored as
+ * <dir>/<pattern>_<n>_<seed>.bin: a header followed by the raw ints. Repeat
+ * runs map the file and copy it out instead of generating again.
+ */
+#define DATA_CACHE_MIN_SIZE 1000000
+#define DATA_CACHE_MAGIC 0x3154414453524f53ULL   // "SORSDAT1"
+
+typedef struct {
+    uint64_t magic;
+    uint64_t seed;
+    int32_t pattern;
+    int32_t n;
+} DataCacheHeader;
+
+static const char *cache_pattern_names[] = {"random", "sorted", "reverse", "nearly"};
 
-        // Swap elements
-        int temp = arr[idx1];
-        arr[idx1] = arr[idx2];
-        arr[idx2] = temp;
+static bool cache_path(char *path, size_t size, int n, DataPattern pattern) {
+    if (generator_cache_dir[0] == '\0' || n < DATA_CACHE_MIN_SIZE) {
+        return false;
+    }
+    int len = snprintf(path, size, "%s/%s_%d_%016llx.bin", generator_cache_dir,
+                       cache_pattern_names[pattern], n, (unsigned long long)generator_seed);
+    return len > 0 && (size_t)len < size;
+}
+
+static bool cache_load(const char *path, int *arr, int n, DataPattern pattern) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    size_t bytes = sizeof(DataCacheHeader) + (size_t)n * sizeof(int);
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size != bytes) {
+        close(fd);
+        return false;
+    }
+    void *map = mmap(NULL, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return false;
+    }
+    posix_madvise(map, bytes, POSIX_MADV_SEQUENTIAL | POSIX_MADV_WILLNEED);
+
+    DataCacheHeader header;
+    memcpy(&header, map, sizeof(header));
+    bool hit = header.magic == DATA_CACHE_MAGIC && header.seed == generator_seed &&
+               header.pattern == (int32_t)pattern && header.n == n;
+    if (hit) {
+        memcpy(arr, (const char *)map + sizeof(header), (size_t)n * sizeof(int));
+    }
+    munmap(map, bytes);
+    return hit;
+}
+
+// Best effort: written under a temporary name and renamed, so readers never see half a file
+static void cache_store(const char *path, const int *arr, int n, DataPattern pattern) {
+    if (mkdir(generator_cache_dir, 0755) != 0 && errno != EEXIST) {
+        return;
+    }
+    char temp_path[320];
+    snprintf(temp_path, sizeof(temp_path), "%s.%ld.tmp", path, (long)getpid());
+    FILE *fp = fopen(temp_path, "wb");
+    if (fp == NULL) {
+        return;
+    }
+
+    DataCacheHeader header = {DATA_CACHE_MAGIC, generator_seed, (int32_t)pattern, n};
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+              fwrite(arr, sizeof(int), (size_t)n, fp) == (size_t)n;
+    if (fclose(fp) != 0) {
+        ok = false;
+    }
+    if (!ok || rename(temp_path, path) != 0) {
+        remove(temp_path);
     }
 }
 
 void generate_data(int *arr, int n, DataPattern pattern) {
-    // Seed random number generator
-    static int seeded = 0;
-    if (!seeded) {
-        srand((unsigned int)time(NULL));
-        seeded = 1;
+    char path[288];
+    bool cached = cache_path(path, sizeof(path), n, pattern);
+    if (cached && cache_load(path, arr, n, pattern)) {
+        return;
     }
 
     switch(pattern) {
@@ -66,4 +294,114 @@ void generate_data(int *arr, int n, DataPattern pattern) {
             generate_nearly_sorted(arr, n, n / 20);
             break;
     }
+
+    if (cached) {
+        cache_store(path, arr, n, pattern);
+    }
+}
+
+/* ========== Typed keys (64-bit integers, float, double) ========== */
+
+/*
+ * Same four patterns as generate_data. Sorted values straddle zero so the
+ * sign handling of the typed sorts is exercised on every pattern; reverse
+ * order is the sorted value of the mirrored index.
+ */
+#define DEFINE_TYPED_GENERATOR(suffix, type, stream, random_value, sorted_value)     \
+    static void fill_##suffix##_range(const FillContext *ctx, int begin, int end) {  \
+        type *arr = (type *)ctx->arr;                                                \
+        uint64_t key = ctx->key;                                                     \
+        int n = ctx->n;                                                              \
+        (void)key;                                                                   \
+        for (int i = begin; i < end; i++) {                                          \
+            if (ctx->pattern == RANDOM) {                                            \
+                arr[i] = (random_value);                                             \
+            } else {                                                                 \
+                int idx = ctx->pattern == REVERSE_SORTED ? n - 1 - i : i;            \
+                arr[i] = (sorted_value);                                             \
+            }                                                                        \
+        }                                                                            \
+    }                                                                                \
+                                                                                     \
+    void generate_data_##suffix(type *arr, int n, DataPattern pattern) {             \
+        FillContext ctx = {arr, n, pattern, stream_key(stream), fill_##suffix##_range}; \
+        fill_parallel(&ctx);                                                         \
+        if (pattern == NEARLY_SORTED) {                                              \
+            APPLY_SWAPS(type, arr, n, n / 20);                                       \
+        }                                                                            \
+    }
+
+DEFINE_TYPED_GENERATOR(i64, int64_t, STREAM_I64, (int64_t)counter_u64(key, (uint64_t)i),
+                       ((int64_t)idx - n / 2) * 4294967311LL)
+DEFINE_TYPED_GENERATOR(u64, uint64_t, STREAM_U64, counter_u64(key, (uint64_t)i),
+                       (uint64_t)idx * 4294967311ULL)
+DEFINE_TYPED_GENERATOR(f32, float, STREAM_F32,
+                       (float)((counter_unit(key, (uint64_t)i) * 2.0 - 1.0) * 1e6),
+                       (float)(idx - n / 2) * 0.5f)
+DEFINE_TYPED_GENERATOR(f64, double, STREAM_F64,
+                       (counter_unit(key, (uint64_t)i) * 2.0 - 1.0) * 1e9,
+                       (double)(idx - n / 2) * 0.25)
+
+/* ========== On-disk inputs for the external sort ========== */
+
+#define DATA_FILE_CHUNK (1 << 20)
+
+int generate_data_file(const char *path, long long count, size_t key_size, DataPattern pattern) {
+    if (key_size != sizeof(int32_t) && key_size != sizeof(int64_t)) {
+        return -1;
+    }
+    FILE *fp = fopen(path, "wb");
+    if (fp == NULL) {
+        return -1;
+    }
+    void *chunk = malloc((size_t)DATA_FILE_CHUNK * key_size);
+    if (chunk == NULL) {
+        fclose(fp);
+        return -1;
+    }
+    uint64_t key = stream_key(key_size == sizeof(int32_t) ? STREAM_INT : STREAM_I64);
+    uint64_t swap_key = stream_key(STREAM_SWAPS);
+
+    int status = 0;
+    for (long long base = 0; base < count && status == 0; base += DATA_FILE_CHUNK) {
+        int n = count - base < DATA_FILE_CHUNK ? (int)(count - base) : DATA_FILE_CHUNK;
+
+        // Values are indexed by file position, so ordered patterns continue across chunks
+        for (int i = 0; i < n; i++) {
+            uint64_t index = (uint64_t)(base + i);
+            long long value;
+            if (pattern == RANDOM) {
+                value = key_size == sizeof(int32_t) ? random_int_at(key, index)
+                                                    : (long long)counter_u64(key, index);
+            } else {
+                value = pattern == REVERSE_SORTED ? count - (base + i) : base + i;
+            }
+            if (key_size == sizeof(int32_t)) {
+                ((int32_t *)chunk)[i] = (int32_t)value;
+            } else {
+                ((int64_t *)chunk)[i] = (int64_t)value;
+            }
+        }
+        // Nearly sorted: 5% swaps, kept within the chunk
+        for (int s = 0; pattern == NEARLY_SORTED && s < n / 20; s++) {
+            uint64_t draw = (uint64_t)(base / 10) + 2 * (uint64_t)s;
+            uint32_t idx1 = counter_bounded(swap_key, draw, (uint32_t)n);
+            uint32_t idx2 = counter_bounded(swap_key, draw + 1, (uint32_t)n);
+            char temp[sizeof(int64_t)];
+            memcpy(temp, (char *)chunk + (size_t)idx1 * key_size, key_size);
+            memcpy((char *)chunk + (size_t)idx1 * key_size,
+                   (char *)chunk + (size_t)idx2 * key_size, key_size);
+            memcpy((char *)chunk + (size_t)idx2 * key_size, temp, key_size);
+        }
+
+        if (fwrite(chunk, key_size, (size_t)n, fp) != (size_t)n) {
+            status = -1;
+        }
+    }
+
+    free(chunk);
+    if (fclose(fp) != 0) {
+        status = -1;
+    }
+    return status;
 }
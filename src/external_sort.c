@@ -0,0 +1,619 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "../include/external_sort.h"
+#include "../include/sorts.h"
+
+// Smallest per-buffer size worth a read(); caps the merge fan-in for a budget
+#define EXTERNAL_MIN_BUFFER ((size_t)256 << 10)
+#define EXTERNAL_MAX_FANIN 512
+
+typedef struct {
+    int fd;
+    off_t bytes;
+} RunFile;
+
+static double elapsed_seconds(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - start->tv_sec) + (double)(now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+size_t external_key_size(ExternalKeyType type) {
+    return type == EXTERNAL_INT64 ? sizeof(int64_t) : sizeof(int32_t);
+}
+
+/* ========== Plain I/O helpers ========== */
+
+// Read until len bytes or end of file; *got receives the byte count
+static int read_full(int fd, void *buf, size_t len, off_t offset, size_t *got) {
+    size_t done = 0;
+    while (done < len) {
+        ssize_t r = pread(fd, (char *)buf + done, len - done, offset + (off_t)done);
+        if (r < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        if (r == 0) {
+            break;
+        }
+        done += (size_t)r;
+    }
+    *got = done;
+    return 0;
+}
+
+static int write_full(int fd, const void *buf, size_t len) {
+    size_t done = 0;
+    while (done < len) {
+        ssize_t w = write(fd, (const char *)buf + done, len - done);
+        if (w < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        done += (size_t)w;
+    }
+    return 0;
+}
+
+// Runs live in unlinked temp files, so nothing is left behind on any exit path
+static int open_temp_run(const char *dir) {
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/sortrun-XXXXXX", dir);
+    int fd = mkstemp(path);
+    if (fd >= 0) {
+        unlink(path);
+    }
+    return fd;
+}
+
+/* ========== Background I/O thread ========== */
+
+typedef struct {
+    bool write;
+    int fd;
+    off_t offset;           // Reads only; writes append at the descriptor offset
+    void *buf;
+    size_t len;             // Read: bytes requested, then bytes read
+    bool finished;
+} IoJob;
+
+typedef struct {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;    // A job was queued or stop was set
+    pthread_cond_t done;    // A job finished
+    IoJob **queue;
+    int capacity;
+    int head;
+    int count;
+    bool stop;
+    int error;              // First errno seen by the thread
+} IoThread;
+
+static void *io_thread_main(void *arg) {
+    IoThread *io = (IoThread *)arg;
+    pthread_mutex_lock(&io->lock);
+    for (;;) {
+        while (io->count == 0 && !io->stop) {
+            pthread_cond_wait(&io->wake, &io->lock);
+        }
+        if (io->count == 0) {
+            break;
+        }
+        IoJob *job = io->queue[io->head];
+        io->head = (io->head + 1) % io->capacity;
+        io->count--;
+        pthread_mutex_unlock(&io->lock);
+
+        int status;
+        if (job->write) {
+            status = write_full(job->fd, job->buf, job->len);
+        } else {
+            size_t got = 0;
+            status = read_full(job->fd, job->buf, job->len, job->offset, &got);
+            job->len = got;
+        }
+
+        pthread_mutex_lock(&io->lock);
+        if (status != 0 && io->error == 0) {
+            io->error = errno;
+        }
+        job->finished = true;
+        pthread_cond_broadcast(&io->done);
+    }
+    pthread_mutex_unlock(&io->lock);
+    return NULL;
+}
+
+static int io_thread_start(IoThread *io, int capacity) {
+    memset(io, 0, sizeof(*io));
+    io->capacity = capacity;
+    io->queue = (IoJob **)malloc((size_t)capacity * sizeof(IoJob *));
+    if (io->queue == NULL) {
+        return -1;
+    }
+    pthread_mutex_init(&io->lock, NULL);
+    pthread_cond_init(&io->wake, NULL);
+    pthread_cond_init(&io->done, NULL);
+    if (pthread_create(&io->thread, NULL, io_thread_main, io) != 0) {
+        pthread_mutex_destroy(&io->lock);
+        pthread_cond_destroy(&io->wake);
+        pthread_cond_destroy(&io->done);
+        free(io->queue);
+        return -1;
+    }
+    return 0;
+}
+
+static void io_thread_stop(IoThread *io) {
+    pthread_mutex_lock(&io->lock);
+    io->stop = true;
+    pthread_cond_signal(&io->wake);
+    pthread_mutex_unlock(&io->lock);
+    pthread_join(io->thread, NULL);
+    pthread_mutex_destroy(&io->lock);
+    pthread_cond_destroy(&io->wake);
+    pthread_cond_destroy(&io->done);
+    free(io->queue);
+}
+
+// Every job owner has at most one job in flight, so the queue never overflows
+static void io_submit(IoThread *io, IoJob *job) {
+    job->finished = false;
+    pthread_mutex_lock(&io->lock);
+    io->queue[(io->head + io->count) % io->capacity] = job;
+    io->count++;
+    pthread_cond_signal(&io->wake);
+    pthread_mutex_unlock(&io->lock);
+}
+
+static int io_wait(IoThread *io, IoJob *job) {
+    pthread_mutex_lock(&io->lock);
+    while (!job->finished) {
+        pthread_cond_wait(&io->done, &io->lock);
+    }
+    int error = io->error;
+    pthread_mutex_unlock(&io->lock);
+    if (error != 0) {
+        errno = error;
+        return -1;
+    }
+    return 0;
+}
+
+/* ========== Double-buffered run reader and output writer ========== */
+
+typedef struct {
+    RunFile run;
+    off_t next_offset;      // File offset of the next read to schedule
+    char *buf[2];
+    IoJob job[2];
+    int front;              // Buffer being consumed; the other one is in flight
+    size_t count;           // Elements in the front buffer
+    size_t pos;
+    bool exhausted;
+} RunReader;
+
+static void reader_schedule(IoThread *io, RunReader *reader, int index, size_t buffer_size) {
+    off_t remaining = reader->run.bytes - reader->next_offset;
+    IoJob *job = &reader->job[index];
+    job->write = false;
+    job->fd = reader->run.fd;
+    job->offset = reader->next_offset;
+    job->buf = reader->buf[index];
+    job->len = remaining < (off_t)buffer_size ? (size_t)remaining : buffer_size;
+    reader->next_offset += (off_t)job->len;
+    if (job->len == 0) {
+        job->finished = true;  // Past the end: nothing to read
+        return;
+    }
+    io_submit(io, job);
+}
+
+// Make the in-flight buffer the front one and schedule a read into the other
+static int reader_flip(IoThread *io, RunReader *reader, size_t elem_size, size_t buffer_size) {
+    int back = 1 - reader->front;
+    if (io_wait(io, &reader->job[back]) != 0) {
+        return -1;
+    }
+    reader->front = back;
+    reader->count = reader->job[back].len / elem_size;
+    reader->pos = 0;
+    reader->exhausted = reader->count == 0;
+    if (!reader->exhausted) {
+        reader_schedule(io, reader, 1 - back, buffer_size);
+    }
+    return 0;
+}
+
+typedef struct {
+    int fd;
+    char *buf[2];
+    IoJob job[2];
+    int front;
+    size_t used;            // Bytes filled in the front buffer
+    size_t size;
+} OutputWriter;
+
+static int writer_flush(IoThread *io, OutputWriter *writer) {
+    int back = 1 - writer->front;
+    // The other buffer may still be on its way to disk
+    if (io_wait(io, &writer->job[back]) != 0) {
+        return -1;
+    }
+    if (writer->used == 0) {
+        return 0;
+    }
+    IoJob *job = &writer->job[writer->front];
+    job->write = true;
+    job->fd = writer->fd;
+    job->buf = writer->buf[writer->front];
+    job->len = writer->used;
+    io_submit(io, job);
+    writer->front = back;
+    writer->used = 0;
+    return 0;
+}
+
+/* ========== k-way merge through a loser tree ========== */
+
+static inline int64_t load_key(const char *p, size_t elem_size) {
+    if (elem_size == sizeof(int32_t)) {
+        int32_t value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+    int64_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static inline void store_key(char *p, int64_t key, size_t elem_size) {
+    if (elem_size == sizeof(int32_t)) {
+        int32_t value = (int32_t)key;
+        memcpy(p, &value, sizeof(value));
+    } else {
+        memcpy(p, &key, sizeof(key));
+    }
+}
+
+typedef struct {
+    int k;
+    int *tree;              // tree[0]: winner, tree[1..k-1]: losers of each match
+    int64_t *keys;          // Current head of every run, plus the sentinel at index k
+    int *rank;              // Tie-break: run index, pushed past every live run once exhausted
+} LoserTree;
+
+/*
+ * Runs compare by (key, rank). An exhausted run keeps its last key but its
+ * rank moves above every live run, so it only wins once all runs are done;
+ * the sentinel (INT64_MIN, -1) at index k beats everything.
+ */
+static inline bool run_less(const LoserTree *lt, int a, int b) {
+    int64_t ka = lt->keys[a];
+    int64_t kb = lt->keys[b];
+    return (ka < kb) | ((ka == kb) & (lt->rank[a] < lt->rank[b]));
+}
+
+// Replay the matches on the path from leaf s to the root (selects, not branches: keys are random)
+static inline void loser_tree_adjust(LoserTree *lt, int s) {
+    for (int t = (s + lt->k) / 2; t > 0; t /= 2) {
+        int other = lt->tree[t];
+        bool other_wins = run_less(lt, other, s);
+        lt->tree[t] = other_wins ? s : other;
+        s = other_wins ? other : s;
+    }
+    lt->tree[0] = s;
+}
+
+static inline void mark_exhausted(LoserTree *lt, int run) {
+    lt->keys[run] = INT64_MAX;
+    lt->rank[run] += lt->k;
+}
+
+static int merge_runs(IoThread *io, RunFile *runs, int k, int out_fd,
+                      size_t elem_size, size_t buffer_size) {
+    RunReader *readers = (RunReader *)calloc((size_t)k, sizeof(RunReader));
+    int *tree = (int *)malloc((size_t)k * sizeof(int));
+    int64_t *keys = (int64_t *)malloc(((size_t)k + 1) * sizeof(int64_t));
+    int *rank = (int *)malloc(((size_t)k + 1) * sizeof(int));
+    char *arena = (char *)malloc((size_t)(2 * k + 2) * buffer_size);
+    int primed = 0;
+    int status = -1;
+
+    OutputWriter writer;
+    writer.fd = out_fd;
+    writer.job[0].finished = true;
+    writer.job[1].finished = true;
+    writer.front = 0;
+    writer.used = 0;
+    writer.size = buffer_size - buffer_size % elem_size;
+
+    if (readers == NULL || tree == NULL || keys == NULL || rank == NULL || arena == NULL) {
+        errno = ENOMEM;
+        goto cleanup;
+    }
+    writer.buf[0] = arena + (size_t)(2 * k) * buffer_size;
+    writer.buf[1] = arena + (size_t)(2 * k + 1) * buffer_size;
+
+    // Prime every run: first buffer synchronously, second one in flight
+    for (int i = 0; i < k; i++, primed++) {
+        RunReader *reader = &readers[i];
+        reader->run = runs[i];
+        reader->buf[0] = arena + (size_t)(2 * i) * buffer_size;
+        reader->buf[1] = arena + (size_t)(2 * i + 1) * buffer_size;
+        reader->front = 1;
+        reader->job[0].finished = true;
+        reader->job[1].finished = true;
+        reader_schedule(io, reader, 0, buffer_size);
+        if (reader_flip(io, reader, elem_size, buffer_size) != 0) {
+            goto cleanup;
+        }
+        rank[i] = i;
+        if (!reader->exhausted) {
+            keys[i] = load_key(reader->buf[reader->front], elem_size);
+        } else {
+            keys[i] = INT64_MAX;
+            rank[i] += k;
+        }
+    }
+
+    LoserTree lt = {k, tree, keys, rank};
+    keys[k] = INT64_MIN;
+    rank[k] = -1;
+    for (int i = 0; i < k; i++) {
+        tree[i] = k;
+    }
+    for (int i = k - 1; i >= 0; i--) {
+        loser_tree_adjust(&lt, i);
+    }
+
+    while (rank[tree[0]] < k) {
+        int w = tree[0];
+        RunReader *reader = &readers[w];
+        store_key(writer.buf[writer.front] + writer.used, keys[w], elem_size);
+        writer.used += elem_size;
+        if (writer.used == writer.size && writer_flush(io, &writer) != 0) {
+            goto cleanup;
+        }
+
+        if (++reader->pos == reader->count &&
+            reader_flip(io, reader, elem_size, buffer_size) != 0) {
+            goto cleanup;
+        }
+        if (!reader->exhausted) {
+            keys[w] = load_key(reader->buf[reader->front] + reader->pos * elem_size, elem_size);
+        } else {
+            mark_exhausted(&lt, w);
+        }
+        loser_tree_adjust(&lt, w);
+    }
+
+    if (writer_flush(io, &writer) == 0) {
+        status = 0;
+    }
+
+cleanup:
+    // No job may still point into the arena once it is freed
+    for (int i = 0; i < primed + (primed < k ? 1 : 0) && readers != NULL && arena != NULL; i++) {
+        io_wait(io, &readers[i].job[0]);
+        io_wait(io, &readers[i].job[1]);
+    }
+    if (io_wait(io, &writer.job[0]) != 0 || io_wait(io, &writer.job[1]) != 0) {
+        status = -1;
+    }
+    free(readers);
+    free(tree);
+    free(keys);
+    free(rank);
+    free(arena);
+    return status;
+}
+
+/* ========== Run generation ========== */
+
+static void sort_chunk(void *chunk, size_t n, ExternalKeyType type, int threads) {
+    if (type == EXTERNAL_INT64) {
+        radix_sort_i64((int64_t *)chunk, (int)n);
+    } else {
+        radix_sort_bits((int *)chunk, (int)n, 8, threads);
+    }
+}
+
+static void close_runs(RunFile *runs, int count) {
+    for (int i = 0; i < count; i++) {
+        close(runs[i].fd);
+    }
+}
+
+int external_sort_file(const char *input_path, const char *output_path,
+                       ExternalKeyType type, const ExternalSortConfig *config,
+                       ExternalSortStats *stats) {
+    ExternalSortStats local_stats;
+    if (stats == NULL) {
+        stats = &local_stats;
+    }
+    memset(stats, 0, sizeof(*stats));
+
+    size_t budget = config != NULL && config->memory_budget > 0 ? config->memory_budget
+                                                                : EXTERNAL_DEFAULT_BUDGET;
+    int threads = config != NULL ? config->threads : 1;
+    const char *temp_dir = config != NULL ? config->temp_dir : NULL;
+    if (temp_dir == NULL) {
+        temp_dir = getenv("TMPDIR");
+    }
+    if (temp_dir == NULL || temp_dir[0] == '\0') {
+        temp_dir = "/tmp";
+    }
+
+    size_t elem_size = external_key_size(type);
+    // Half the budget holds the chunk, half is the radix scratch buffer
+    size_t chunk_elems = budget / (2 * elem_size);
+    if (chunk_elems < 1024) {
+        chunk_elems = 1024;
+    }
+    if (chunk_elems > (size_t)INT32_MAX) {
+        chunk_elems = (size_t)INT32_MAX;
+    }
+
+    int in_fd = open(input_path, O_RDONLY);
+    if (in_fd < 0) {
+        return -1;
+    }
+    struct stat st;
+    if (fstat(in_fd, &st) != 0) {
+        close(in_fd);
+        return -1;
+    }
+    if (st.st_size % (off_t)elem_size != 0) {
+        close(in_fd);
+        errno = EINVAL;  // Not a whole number of keys
+        return -1;
+    }
+    posix_fadvise(in_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    stats->elements = (uint64_t)st.st_size / elem_size;
+
+    int out_fd = open(output_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (out_fd < 0) {
+        close(in_fd);
+        return -1;
+    }
+
+    void *chunk = malloc(chunk_elems * elem_size);
+    int run_capacity = (int)(stats->elements / chunk_elems) + 1;
+    RunFile *runs = (RunFile *)malloc((size_t)run_capacity * sizeof(RunFile));
+    int run_count = 0;
+    int status = -1;
+    if (chunk == NULL || runs == NULL) {
+        errno = ENOMEM;
+        goto done;
+    }
+
+    // Stage 1: sorted runs
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    off_t offset = 0;
+    while (offset < st.st_size) {
+        size_t got;
+        if (read_full(in_fd, chunk, chunk_elems * elem_size, offset, &got) != 0) {
+            goto done;
+        }
+        if (got == 0) {
+            break;
+        }
+        offset += (off_t)got;
+        sort_chunk(chunk, got / elem_size, type, threads);
+
+        // A single chunk is the whole answer: skip the spill and the merge
+        if (run_count == 0 && offset >= st.st_size) {
+            if (write_full(out_fd, chunk, got) != 0) {
+                goto done;
+            }
+            stats->runs = 1;
+            stats->run_seconds = elapsed_seconds(&start);
+            status = 0;
+            goto done;
+        }
+
+        int run_fd = open_temp_run(temp_dir);
+        if (run_fd < 0) {
+            goto done;
+        }
+        runs[run_count].fd = run_fd;
+        runs[run_count].bytes = (off_t)got;
+        run_count++;
+        if (write_full(run_fd, chunk, got) != 0) {
+            goto done;
+        }
+    }
+    free(chunk);
+    chunk = NULL;
+    stats->runs = run_count;
+    stats->run_seconds = elapsed_seconds(&start);
+
+    if (run_count == 0) {
+        status = 0;  // Empty input
+        goto done;
+    }
+
+    // Stage 2: merge passes, each within the memory budget
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int max_fanin = (int)(budget / (2 * EXTERNAL_MIN_BUFFER)) - 1;
+    if (max_fanin < 2) {
+        max_fanin = 2;
+    }
+    if (max_fanin > EXTERNAL_MAX_FANIN) {
+        max_fanin = EXTERNAL_MAX_FANIN;
+    }
+
+    IoThread io;
+    if (io_thread_start(&io, 2 * max_fanin + 4) != 0) {
+        errno = ENOMEM;
+        goto done;
+    }
+
+    while (run_count > 0) {
+        bool final_pass = run_count <= max_fanin;
+        int produced = 0;
+        for (int first = 0; first < run_count; first += max_fanin) {
+            int k = run_count - first < max_fanin ? run_count - first : max_fanin;
+            size_t buffer_size = budget / (size_t)(2 * k + 2);
+            buffer_size -= buffer_size % elem_size;
+            if (buffer_size < elem_size) {
+                buffer_size = elem_size;
+            }
+
+            int target_fd = final_pass ? out_fd : open_temp_run(temp_dir);
+            if (target_fd < 0 || merge_runs(&io, runs + first, k, target_fd,
+                                            elem_size, buffer_size) != 0) {
+                if (target_fd >= 0 && !final_pass) {
+                    close(target_fd);
+                }
+                close_runs(runs + first, run_count - first);
+                close_runs(runs, produced);
+                run_count = 0;
+                io_thread_stop(&io);
+                goto done;
+            }
+            close_runs(runs + first, k);
+
+            if (!final_pass) {
+                off_t bytes = 0;
+                for (int i = first; i < first + k; i++) {
+                    bytes += runs[i].bytes;
+                }
+                // Merged runs are consumed in order, so slot `produced` is free
+                runs[produced].fd = target_fd;
+                runs[produced].bytes = bytes;
+                produced++;
+            }
+        }
+        stats->merge_passes++;
+        run_count = produced;
+    }
+    io_thread_stop(&io);
+    stats->merge_seconds = elapsed_seconds(&start);
+    status = 0;
+
+done:
+    close_runs(runs, run_count);
+    free(runs);
+    free(chunk);
+    close(in_fd);
+    if (close(out_fd) != 0) {
+        status = -1;
+    }
+    return status;
+}
@@ -0,0 +1,89 @@
+// MAP_ANONYMOUS, MADV_HUGEPAGE and the cache-size sysconf names are outside strict POSIX
+#define _DEFAULT_SOURCE
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "../include/hygiene.h"
+
+// LLC size assumed when the C library cannot report it
+#define HYGIENE_DEFAULT_LLC (32u << 20)
+// Eviction sweep size in LLC sizes; non-LRU replacement needs more than one
+#define HYGIENE_EVICT_FACTOR 4
+#define HYGIENE_CACHE_LINE 64
+
+static int lock_failures = 0;
+static unsigned char *evict_buffer = NULL;  // Kept for the life of the process
+static size_t evict_bytes = 0;
+
+static size_t page_round(size_t bytes) {
+    long page = sysconf(_SC_PAGESIZE);
+    size_t size = page > 0 ? (size_t)page : 4096;
+    return (bytes + size - 1) / size * size;
+}
+
+void *hygiene_alloc(size_t bytes, bool huge_pages) {
+    if (bytes == 0) {
+        return NULL;
+    }
+    size_t length = page_round(bytes);
+    void *buffer = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buffer == MAP_FAILED) {
+        return NULL;
+    }
+#ifdef MADV_HUGEPAGE
+    // Advisory: the kernel backs whichever 2 MB-aligned spans it can
+    if (huge_pages) {
+        madvise(buffer, length, MADV_HUGEPAGE);
+    }
+#else
+    (void)huge_pages;
+#endif
+    // Write every page so the faults happen here, then pin the pages
+    memset(buffer, 0, length);
+    if (mlock(buffer, length) != 0) {
+        lock_failures++;
+    }
+    return buffer;
+}
+
+void hygiene_free(void *buffer, size_t bytes) {
+    if (buffer == NULL) {
+        return;
+    }
+    size_t length = page_round(bytes);
+    munlock(buffer, length);
+    munmap(buffer, length);
+}
+
+int hygiene_lock_failures(void) {
+    return lock_failures;
+}
+
+size_t hygiene_llc_bytes(void) {
+    long cache = -1;
+#ifdef _SC_LEVEL3_CACHE_SIZE
+    cache = sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    if (cache <= 0) {
+        cache = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    }
+#endif
+    return cache > 0 ? (size_t)cache : HYGIENE_DEFAULT_LLC;
+}
+
+void hygiene_evict_caches(void) {
+    if (evict_buffer == NULL) {
+        evict_bytes = hygiene_llc_bytes() * HYGIENE_EVICT_FACTOR;
+        evict_buffer = (unsigned char *)hygiene_alloc(evict_bytes, false);
+        if (evict_buffer == NULL) {
+            return;
+        }
+    }
+    // Read-modify-write: the lines come in exclusive and displace dirty benchmark data too
+    volatile unsigned char *sweep = evict_buffer;
+    for (size_t i = 0; i < evict_bytes; i += HYGIENE_CACHE_LINE) {
+        sweep[i]++;
+    }
+}
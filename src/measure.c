@@ -0,0 +1,130 @@
+#include <math.h>
+#include <stdlib.h>
+#include "../include/measure.h"
+
+static MeasureConfig measure_settings = MEASURE_DEFAULT_CONFIG;
+static bool warming_up = false;
+
+bool measure_in_warmup(void) {
+    return warming_up;
+}
+
+void measure_set_config(const MeasureConfig *config) {
+    measure_settings = *config;
+    if (measure_settings.warmup < 0) {
+        measure_settings.warmup = 0;
+    }
+    if (measure_settings.repetitions < 1) {
+        measure_settings.repetitions = 1;
+    }
+    if (measure_settings.max_repetitions < measure_settings.repetitions) {
+        measure_settings.max_repetitions = measure_settings.repetitions;
+    }
+}
+
+const MeasureConfig *measure_config(void) {
+    return &measure_settings;
+}
+
+// Two-sided 95% Student t quantiles for 1..30 degrees of freedom
+static const double T_QUANTILE_95[] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+};
+
+static double t_quantile(int dof) {
+    if (dof <= 0) {
+        return 0.0;
+    }
+    return dof <= 30 ? T_QUANTILE_95[dof - 1] : 1.960;
+}
+
+static int compare_double(const void *a, const void *b) {
+    double lhs = *(const double *)a;
+    double rhs = *(const double *)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+// Mean, sample stddev and CI half-width; order statistics are filled in at the end
+static void update_moments(TimingStats *stats, const double *samples, int count) {
+    double sum = 0.0;
+    for (int i = 0; i < count; i++) {
+        sum += samples[i];
+    }
+    stats->runs = count;
+    stats->mean = sum / count;
+
+    double squares = 0.0;
+    for (int i = 0; i < count; i++) {
+        double d = samples[i] - stats->mean;
+        squares += d * d;
+    }
+    stats->stddev = count > 1 ? sqrt(squares / (count - 1)) : 0.0;
+    stats->ci95 = count > 1 ? t_quantile(count - 1) * stats->stddev / sqrt((double)count) : 0.0;
+}
+
+static void finish_order_stats(TimingStats *stats, double *samples, int count) {
+    qsort(samples, (size_t)count, sizeof(double), compare_double);
+    stats->min = samples[0];
+    stats->median = count % 2 ? samples[count / 2]
+                              : 0.5 * (samples[count / 2 - 1] + samples[count / 2]);
+    // Nearest-rank percentile
+    int rank = (int)ceil(0.95 * count);
+    stats->p95 = samples[rank > 0 ? rank - 1 : 0];
+}
+
+TimingStats measure_trials(TrialFn trial, void *ctx) {
+    const MeasureConfig *config = &measure_settings;
+    TimingStats stats = {0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    int capacity = config->target_ci > 0.0 ? config->max_repetitions : config->repetitions;
+    double *samples = (double *)malloc((size_t)capacity * sizeof(double));
+    if (samples == NULL) {
+        return stats;
+    }
+
+    int count = 0;
+    double spent = 0.0;
+    for (int w = 0; w < config->warmup; w++) {
+        warming_up = true;
+        double time = trial(ctx);
+        warming_up = false;
+        if (time < 0) {
+            free(samples);
+            return stats;
+        }
+        spent += time;
+        // A run longer than the whole budget is not skewed by warm-up; keep it as a sample
+        if (time >= config->time_budget) {
+            samples[count++] = time;
+            break;
+        }
+    }
+
+    while (count < capacity) {
+        if (count > 0) {
+            if (spent >= config->time_budget) {
+                break;
+            }
+            if (count >= config->repetitions) {
+                update_moments(&stats, samples, count);
+                if (config->target_ci <= 0.0 || stats.ci95 <= config->target_ci * stats.mean) {
+                    break;
+                }
+            }
+        }
+        double time = trial(ctx);
+        if (time < 0) {
+            break;
+        }
+        samples[count++] = time;
+        spent += time;
+    }
+
+    if (count > 0) {
+        update_moments(&stats, samples, count);
+        finish_order_stats(&stats, samples, count);
+    }
+    free(samples);
+    return stats;
+}
@@ -0,0 +1,122 @@
+// syscall() and the perf ioctls are outside strict POSIX
+#define _DEFAULT_SOURCE
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
+#include "../include/perf_counters.h"
+
+static const char *counter_names[PERF_COUNTER_COUNT] = {
+    "cycles", "instructions", "branch-misses", "L1d-misses", "LLC-misses", "dTLB-misses"
+};
+
+const char *perf_counter_name(PerfCounter counter) {
+    return counter >= 0 && counter < PERF_COUNTER_COUNT ? counter_names[counter] : "unknown";
+}
+
+#ifdef __linux__
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+
+#define CACHE_READ_MISS(cache) \
+    ((cache) | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+static const struct {
+    uint32_t type;
+    uint64_t config;
+} counter_events[PERF_COUNTER_COUNT] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, CACHE_READ_MISS(PERF_COUNT_HW_CACHE_L1D)},
+    {PERF_TYPE_HW_CACHE, CACHE_READ_MISS(PERF_COUNT_HW_CACHE_LL)},
+    {PERF_TYPE_HW_CACHE, CACHE_READ_MISS(PERF_COUNT_HW_CACHE_DTLB)},
+};
+
+static int counter_fds[PERF_COUNTER_COUNT] = {-1, -1, -1, -1, -1, -1};
+static bool counters_opened = false;
+
+static int open_counter(PerfCounter counter) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = counter_events[counter].type;
+    attr.config = counter_events[counter].config;
+    attr.disabled = 1;
+    attr.inherit = 1;           // Count pool workers created inside the region
+    attr.exclude_kernel = 1;    // Allowed at perf_event_paranoid <= 2
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+int perf_counters_open(void) {
+    int opened = 0;
+    for (int c = 0; c < PERF_COUNTER_COUNT; c++) {
+        if (!counters_opened) {
+            counter_fds[c] = open_counter((PerfCounter)c);
+        }
+        opened += counter_fds[c] >= 0;
+    }
+    counters_opened = true;
+    return opened;
+}
+
+void perf_counters_close(void) {
+    for (int c = 0; c < PERF_COUNTER_COUNT; c++) {
+        if (counter_fds[c] >= 0) {
+            close(counter_fds[c]);
+            counter_fds[c] = -1;
+        }
+    }
+    counters_opened = false;
+}
+
+void perf_counters_start(void) {
+    for (int c = 0; c < PERF_COUNTER_COUNT; c++) {
+        if (counter_fds[c] >= 0) {
+            ioctl(counter_fds[c], PERF_EVENT_IOC_RESET, 0);
+            ioctl(counter_fds[c], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+void perf_counters_stop(PerfSample *sample) {
+    for (int c = 0; c < PERF_COUNTER_COUNT; c++) {
+        if (counter_fds[c] >= 0) {
+            ioctl(counter_fds[c], PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+    for (int c = 0; c < PERF_COUNTER_COUNT; c++) {
+        uint64_t data[3];   // value, time enabled, time running
+        if (counter_fds[c] < 0 || read(counter_fds[c], data, sizeof(data)) != (ssize_t)sizeof(data)) {
+            continue;
+        }
+        if (data[2] == 0) {
+            continue;       // Never scheduled on the PMU
+        }
+        // Scale up if the kernel multiplexed this counter with others
+        double scaled = (double)data[0] * ((double)data[1] / (double)data[2]);
+        sample->values[c] += (uint64_t)scaled;
+        sample->valid[c] = true;
+    }
+}
+
+#else
+
+int perf_counters_open(void) {
+    return 0;
+}
+
+void perf_counters_close(void) {
+}
+
+void perf_counters_start(void) {
+}
+
+void perf_counters_stop(PerfSample *sample) {
+    (void)sample;
+}
+
+#endif
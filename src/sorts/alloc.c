@@ -0,0 +1,80 @@
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../include/sort_alloc.h"
+
+/*
+ * Each block carries its size in a header, so sort_free can account for it
+ * without a lookup. The header is a full max_align_t so the caller's pointer
+ * keeps malloc's alignment.
+ */
+#define ALLOC_HEADER alignof(max_align_t)
+
+static atomic_ullong allocations;
+static atomic_ullong bytes_requested;
+static atomic_ullong live_bytes;
+static atomic_ullong peak_bytes;
+static atomic_ullong baseline_bytes;    // live_bytes at the last reset
+
+static void *account(char *block, size_t bytes) {
+    if (block == NULL) {
+        return NULL;
+    }
+    memcpy(block, &bytes, sizeof(bytes));
+    atomic_fetch_add_explicit(&allocations, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&bytes_requested, bytes, memory_order_relaxed);
+
+    unsigned long long live =
+        atomic_fetch_add_explicit(&live_bytes, bytes, memory_order_relaxed) + bytes;
+    unsigned long long peak = atomic_load_explicit(&peak_bytes, memory_order_relaxed);
+    while (live > peak &&
+           !atomic_compare_exchange_weak_explicit(&peak_bytes, &peak, live,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+    }
+    return block + ALLOC_HEADER;
+}
+
+void *sort_malloc(size_t bytes) {
+    if (bytes > SIZE_MAX - ALLOC_HEADER) {
+        return NULL;
+    }
+    return account((char *)malloc(ALLOC_HEADER + bytes), bytes);
+}
+
+void *sort_calloc(size_t count, size_t size) {
+    if (size != 0 && count > (SIZE_MAX - ALLOC_HEADER) / size) {
+        return NULL;
+    }
+    size_t bytes = count * size;
+    return account((char *)calloc(1, ALLOC_HEADER + bytes), bytes);
+}
+
+void sort_free(void *ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+    char *block = (char *)ptr - ALLOC_HEADER;
+    size_t bytes;
+    memcpy(&bytes, block, sizeof(bytes));
+    atomic_fetch_sub_explicit(&live_bytes, bytes, memory_order_relaxed);
+    free(block);
+}
+
+void sort_alloc_reset(void) {
+    unsigned long long live = atomic_load(&live_bytes);
+    atomic_store(&allocations, 0);
+    atomic_store(&bytes_requested, 0);
+    atomic_store(&baseline_bytes, live);
+    atomic_store(&peak_bytes, live);
+}
+
+SortAllocStats sort_alloc_read(void) {
+    SortAllocStats stats;
+    unsigned long long baseline = atomic_load(&baseline_bytes);
+    unsigned long long peak = atomic_load(&peak_bytes);
+    stats.allocations = atomic_load(&allocations);
+    stats.bytes_requested = atomic_load(&bytes_requested);
+    stats.peak_bytes = peak > baseline ? peak - baseline : 0;
+    return stats;
+}
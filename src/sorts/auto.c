@@ -0,0 +1,188 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include "../../include/sorts.h"
+#include "../../include/sort_kernels.h"
+#include "../../include/sort_instrument.h"
+
+/*
+ * Dispatch rules, from timings of every engine on random, sorted, reverse,
+ * nearly sorted, two-run and few-distinct inputs of 256 to 1M keys:
+ *
+ * - Ascending or descending input is finished by the scan itself.
+ * - Dense keys go to counting sort: a range up to n/2 in any order, or up
+ *   to n when long runs walk the counter table in order.
+ * - Below a few thousand keys the radix histograms do not pay off. Bottom-up
+ *   merge (network-sorted leaf runs) wins on shuffled keys, and on anything
+ *   under a thousand keys; in between, intro sort wins when its partial
+ *   insertion pass can exploit long runs or its equal-key partition can
+ *   exploit duplicates.
+ * - Above that, radix sort wins unless the input is a few long sorted runs,
+ *   which bottom-up merge handles at close to one pass per level.
+ *
+ * Quick sort is never chosen: intro sort matches it on random input and its
+ * Lomuto partition goes quadratic on duplicate-heavy input.
+ */
+
+// Inputs this small go straight to insertion sort, without the scan
+#define AUTO_INSERTION_MAX 16
+// Below this, bottom-up merge wins on any input the scan did not settle
+#define AUTO_MERGE_ONLY 1024
+// Smallest input for radix sort
+#define AUTO_RADIX_MIN 8192
+// Mean run length from which intro sort beats bottom-up merge on small inputs
+#define AUTO_PRESORTED_RUN 8
+// Mean run length from which bottom-up merge beats radix sort on large inputs
+#define AUTO_LONG_RUN 256
+// Keys sampled for duplicates (sorted with one network kernel call)
+#define AUTO_SAMPLE_SIZE SORT_KERNEL_MAX
+
+static _Thread_local SortAutoDecision last_decision;
+
+static const char *engine_names[] = {
+    "AlreadySorted",
+    "Reverse",
+    "InsertionSort",
+    "CountingSortRange",
+    "MergeSortBottomUp",
+    "IntroSort",
+    "RadixSort"
+};
+
+const char *sort_auto_engine_name(SortAutoEngine engine) {
+    if (engine < SORT_AUTO_NONE || engine > SORT_AUTO_RADIX) {
+        return "unknown";
+    }
+    return engine_names[engine];
+}
+
+SortAutoDecision sort_auto_last_decision(void) {
+    return last_decision;
+}
+
+// Count the distinct keys among AUTO_SAMPLE_SIZE evenly spaced ones
+static void sample_distinct(const int *arr, SortAutoDecision *d) {
+    int sample[AUTO_SAMPLE_SIZE];
+    int count = d->n < AUTO_SAMPLE_SIZE ? d->n : AUTO_SAMPLE_SIZE;
+    for (int i = 0; i < count; i++) {
+        sample[i] = arr[(long long)i * d->n / count];
+    }
+    SORT_READS(count);
+    small_sort(sample, count);
+
+    int distinct = 1;
+    for (int i = 1; i < count; i++) {
+        distinct += sample[i] != sample[i - 1];
+    }
+    d->sample_size = count;
+    d->sample_distinct = distinct;
+}
+
+static SortAutoEngine choose_engine(const int *arr, SortAutoDecision *d, bool descending) {
+    if (d->runs == 1) {
+        d->reason = "already ascending";
+        return SORT_AUTO_NONE;
+    }
+    if (descending) {
+        d->reason = "descending";
+        return SORT_AUTO_REVERSE;
+    }
+    // Shuffled keys scatter across the counter table, which only pays off well under n wide
+    long long mean_run = d->n / d->runs;
+    if (d->range <= d->n / 2) {
+        d->reason = "dense keys";
+        return SORT_AUTO_COUNTING;
+    }
+    if (d->range <= d->n && mean_run >= AUTO_PRESORTED_RUN) {
+        d->reason = "dense keys, presorted";
+        return SORT_AUTO_COUNTING;
+    }
+
+    if (d->n < AUTO_MERGE_ONLY) {
+        d->reason = "small";
+        return SORT_AUTO_MERGE;
+    }
+    if (d->n < AUTO_RADIX_MIN) {
+        if (mean_run >= AUTO_PRESORTED_RUN) {
+            d->reason = "small, presorted";
+            return SORT_AUTO_INTRO;
+        }
+        // Only this choice depends on duplicates, so only it pays for the sample
+        sample_distinct(arr, d);
+        if (d->sample_distinct * 4 <= d->sample_size) {
+            d->reason = "small, many duplicates";
+            return SORT_AUTO_INTRO;
+        }
+        d->reason = "small, shuffled";
+        return SORT_AUTO_MERGE;
+    }
+    if (mean_run >= AUTO_LONG_RUN) {
+        d->reason = "few long runs";
+        return SORT_AUTO_MERGE;
+    }
+    d->reason = "wide keys, shuffled";
+    return SORT_AUTO_RADIX;
+}
+
+void sort_auto(int *arr, int n) {
+    SortAutoDecision d = {SORT_AUTO_INSERTION, n, 0, 0, 0, 0, "tiny input"};
+    if (arr == NULL || n <= 1) {
+        d.engine = SORT_AUTO_NONE;
+        last_decision = d;
+        return;
+    }
+    if (n <= AUTO_INSERTION_MAX) {
+        last_decision = d;
+        insertion_sort(arr, n);
+        return;
+    }
+
+    // One pass: key range, and descents/ascents between neighbours
+    int lo = arr[0];
+    int hi = arr[0];
+    int prev = arr[0];
+    int descents = 0;
+    int ascents = 0;
+    for (int i = 1; i < n; i++) {
+        int value = arr[i];
+        lo = value < lo ? value : lo;
+        hi = value > hi ? value : hi;
+        descents += value < prev;
+        ascents += value > prev;
+        prev = value;
+    }
+    SORT_READS(n);
+    SORT_COMPARES(4 * (long long)(n - 1));
+
+    d.range = (long long)hi - lo + 1;
+    d.runs = descents + 1;
+    d.engine = choose_engine(arr, &d, ascents == 0);
+    last_decision = d;
+
+    switch (d.engine) {
+        case SORT_AUTO_NONE:
+            break;
+        case SORT_AUTO_REVERSE:
+            for (int i = 0, j = n - 1; i < j; i++, j--) {
+                int temp = arr[i];
+                arr[i] = arr[j];
+                arr[j] = temp;
+            }
+            SORT_SWAPS(n / 2);
+            break;
+        case SORT_AUTO_INSERTION:
+            insertion_sort(arr, n);
+            break;
+        case SORT_AUTO_COUNTING:
+            counting_sort_range(arr, n, 1);
+            break;
+        case SORT_AUTO_MERGE:
+            merge_sort_bottom_up(arr, n);
+            break;
+        case SORT_AUTO_INTRO:
+            intro_sort(arr, n);
+            break;
+        case SORT_AUTO_RADIX:
+            radix_sort(arr, n);
+            break;
+    }
+}
@@ -1,45 +1,121 @@
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 #include "../../include/sorts.h"
+#include "../../include/sort_alloc.h"
+#include "../../include/sort_kernels.h"
+#include "../../include/sort_instrument.h"
+#include "../../include/sort_tuning.h"
 
-typedef struct {
-    int *data;
-    int count;
-    int capacity;
-} Bucket;
+// Buckets up to this size are finished by small_sort, larger ones by radix
+#define BUCKET_SMALL_SORT (2 * SORT_KERNEL_MAX)
+// L2 size assumed when the C library cannot report it
+#define BUCKET_DEFAULT_L2 (256 * 1024)
+#define BUCKET_RADIX_BITS 8
+#define BUCKET_RADIX_SIZE (1 << BUCKET_RADIX_BITS)
 
-static void bucket_init(Bucket *bucket, int initial_capacity) {
-    bucket->data = (int *)malloc(initial_capacity * sizeof(int));
-    bucket->count = 0;
-    bucket->capacity = bucket->data ? initial_capacity : 0;
+// Largest power-of-two bucket count whose offset table fits in half of L2
+static int max_bucket_count(void) {
+    long cache = -1;
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    cache = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+    if (cache <= 0) {
+        cache = BUCKET_DEFAULT_L2;
+    }
+    long limit = cache / 2 / (long)sizeof(unsigned int);
+    int count = 1;
+    while ((long)count * 2 <= limit && count < (1 << 20)) {
+        count *= 2;
+    }
+    return count;
 }
 
-static void bucket_push(Bucket *bucket, int value) {
-    if (bucket->count >= bucket->capacity) {
-        int new_capacity = bucket->capacity == 0 ? 8 : bucket->capacity * 2;
-        int *new_data = (int *)realloc(bucket->data, new_capacity * sizeof(int));
-        if (new_data == NULL) {
-            return;
-        }
-        bucket->data = new_data;
-        bucket->capacity = new_capacity;
+static int choose_bucket_count(int n, uint64_t range) {
+    int count = 1;
+    int limit = max_bucket_count();
+    // Aim for buckets about the target size so most finish inside the sorting network
+    int target = sort_tuning_get(TUNE_BUCKET_TARGET);
+    while (count < limit && (long long)count * target < n) {
+        count *= 2;
     }
-    bucket->data[bucket->count++] = value;
+    // Never more buckets than distinct keys: each bucket then holds one value
+    if ((uint64_t)count > range) {
+        count = (int)range;
+    }
+    return count;
 }
 
-static int compare_ints(const void *a, const void *b) {
-    int lhs = *(const int *)a;
-    int rhs = *(const int *)b;
-    return (lhs > rhs) - (lhs < rhs);
+/*
+ * LSD radix sort of src[0, n) into dst on keys (value - lo), which fit in
+ * `bits` bits. src doubles as the ping-pong buffer.
+ */
+static void radix_finish(int *src, int *dst, int n, unsigned int lo, int bits) {
+    unsigned int count[BUCKET_RADIX_SIZE];
+    int *from = src;
+    int *to = dst;
+
+    for (int shift = 0; shift < bits; shift += BUCKET_RADIX_BITS) {
+        memset(count, 0, sizeof(count));
+        for (int i = 0; i < n; i++) {
+            count[(((unsigned int)from[i] - lo) >> shift) & (BUCKET_RADIX_SIZE - 1)]++;
+        }
+        SORT_READS(n);
+        unsigned int sum = 0;
+        for (int d = 0; d < BUCKET_RADIX_SIZE; d++) {
+            unsigned int c = count[d];
+            count[d] = sum;
+            sum += c;
+        }
+        for (int i = 0; i < n; i++) {
+            to[count[(((unsigned int)from[i] - lo) >> shift) & (BUCKET_RADIX_SIZE - 1)]++] = from[i];
+        }
+        SORT_MOVES(n);
+        int *swap = from;
+        from = to;
+        to = swap;
+    }
+
+    if (from != dst) {
+        memcpy(dst, from, (size_t)n * sizeof(int));
+        SORT_MOVES(n);
+    }
 }
 
-static void bucket_free(Bucket *bucket) {
-    free(bucket->data);
-    bucket->data = NULL;
-    bucket->count = 0;
-    bucket->capacity = 0;
+// Sort bucket src[0, n) into dst[0, n); src may be clobbered
+static void finish_bucket(int *src, int *dst, int n) {
+    if (n <= BUCKET_SMALL_SORT) {
+        memcpy(dst, src, (size_t)n * sizeof(int));
+        SORT_MOVES(n);
+        small_sort(dst, n);
+        return;
+    }
+
+    int lo = src[0];
+    int hi = src[0];
+    for (int i = 1; i < n; i++) {
+        lo = src[i] < lo ? src[i] : lo;
+        hi = src[i] > hi ? src[i] : hi;
+    }
+    SORT_READS(n);
+    SORT_COMPARES(2 * (n - 1));
+    unsigned int span = (unsigned int)hi - (unsigned int)lo;
+    int bits = 0;
+    while (bits < 32 && (span >> bits) != 0) {
+        bits++;
+    }
+    radix_finish(src, dst, n, (unsigned int)lo, bits);
 }
 
+/*
+ * Bucket sort over one contiguous scratch buffer:
+ *   1. min/max scan, then pick a power-of-two bucket count from n and L2 size
+ *   2. counting pre-pass sizes every bucket, prefix sums give their offsets
+ *   3. scatter arr into scratch; bucket index is a 32x32->64 multiply-shift
+ *   4. finish each bucket from scratch back into its slot in arr
+ */
 void bucket_sort(int *arr, int n) {
     if (arr == NULL || n <= 1) {
         return;
@@ -48,50 +124,59 @@ void bucket_sort(int *arr, int n) {
     int min_val = arr[0];
     int max_val = arr[0];
     for (int i = 1; i < n; i++) {
-        if (arr[i] < min_val) {
-            min_val = arr[i];
-        }
-        if (arr[i] > max_val) {
-            max_val = arr[i];
-        }
+        min_val = arr[i] < min_val ? arr[i] : min_val;
+        max_val = arr[i] > max_val ? arr[i] : max_val;
     }
-
+    SORT_READS(n);
+    SORT_COMPARES(2 * (n - 1));
     if (min_val == max_val) {
         return;
     }
 
-    int bucket_count = n < 1024 ? n : 1024;
-    Bucket *buckets = (Bucket *)malloc(bucket_count * sizeof(Bucket));
-    if (buckets == NULL) {
+    uint64_t range = (uint64_t)((unsigned int)max_val - (unsigned int)min_val) + 1;
+    int bucket_count = choose_bucket_count(n, range);
+    // index = (key * scale) >> 32 stays below bucket_count for every key < range
+    uint64_t scale = ((uint64_t)bucket_count << 32) / range;
+
+    unsigned int *offsets = (unsigned int *)sort_calloc((size_t)bucket_count + 1, sizeof(unsigned int));
+    int *scratch = (int *)sort_malloc((size_t)n * sizeof(int));
+    if (offsets == NULL || scratch == NULL) {
+        sort_free(offsets);
+        sort_free(scratch);
         return;
     }
 
-    for (int i = 0; i < bucket_count; i++) {
-        bucket_init(&buckets[i], 8);
+    for (int i = 0; i < n; i++) {
+        uint64_t key = (unsigned int)arr[i] - (unsigned int)min_val;
+        offsets[((key * scale) >> 32) + 1]++;
     }
-
-    double interval = (double)(max_val - min_val + 1) / bucket_count;
-    if (interval == 0.0) {
-        interval = 1.0;
+    SORT_READS(n);
+    for (int b = 0; b < bucket_count; b++) {
+        offsets[b + 1] += offsets[b];
     }
 
+    // offsets[b] doubles as bucket b's write cursor during the scatter
     for (int i = 0; i < n; i++) {
-        int index = (int)((arr[i] - min_val) / interval);
-        if (index >= bucket_count) {
-            index = bucket_count - 1;
-        }
-        bucket_push(&buckets[index], arr[i]);
+        uint64_t key = (unsigned int)arr[i] - (unsigned int)min_val;
+        scratch[offsets[(key * scale) >> 32]++] = arr[i];
     }
+    SORT_MOVES(n);
 
-    int pos = 0;
-    for (int i = 0; i < bucket_count; i++) {
-        if (buckets[i].count > 0) {
-            qsort(buckets[i].data, buckets[i].count, sizeof(int), compare_ints);
-            memcpy(&arr[pos], buckets[i].data, buckets[i].count * sizeof(int));
-            pos += buckets[i].count;
+    // After the scatter offsets[b] is the end of bucket b
+    unsigned int start = 0;
+    bool one_value_per_bucket = (uint64_t)bucket_count == range;
+    for (int b = 0; b < bucket_count; b++) {
+        unsigned int end = offsets[b];
+        int size = (int)(end - start);
+        if (one_value_per_bucket || size <= 1) {
+            memcpy(arr + start, scratch + start, (size_t)size * sizeof(int));
+            SORT_MOVES(size);
+        } else {
+            finish_bucket(scratch + start, arr + start, size);
         }
-        bucket_free(&buckets[i]);
+        start = end;
     }
 
-    free(buckets);
+    sort_free(offsets);
+    sort_free(scratch);
 }
@@ -1,6 +1,12 @@
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include "../../include/sorts.h"
+#include "../../include/sort_alloc.h"
+#include "../../include/sort_instrument.h"
+#include "../../include/sort_tuning.h"
+#include "../../include/thread_pool.h"
 
 void counting_sort(int *arr, int n, int max_val) {
     if (arr == NULL || n <= 1 || max_val < 0) {
@@ -8,19 +14,20 @@ void counting_sort(int *arr, int n, int max_val) {
     }
 
     int range = max_val + 1;
-    int *count = (int *)calloc(range, sizeof(int));
-    int *output = (int *)malloc(n * sizeof(int));
+    int *count = (int *)sort_calloc(range, sizeof(int));
+    int *output = (int *)sort_malloc(n * sizeof(int));
 
     if (count == NULL || output == NULL) {
-        free(count);
-        free(output);
+        sort_free(count);
+        sort_free(output);
         return;
     }
 
     for (int i = 0; i < n; i++) {
+        SORT_READS(1);
         if (arr[i] < 0) {
-            free(count);
-            free(output);
+            sort_free(count);
+            sort_free(output);
             return;
         }
         count[arr[i]]++;
@@ -34,11 +41,245 @@ void counting_sort(int *arr, int n, int max_val) {
         output[count[arr[i]] - 1] = arr[i];
         count[arr[i]]--;
     }
+    SORT_MOVES(n);
 
     for (int i = 0; i < n; i++) {
         arr[i] = output[i];
     }
+    SORT_MOVES(n);
 
-    free(count);
-    free(output);
+    sort_free(count);
+    sort_free(output);
+}
+
+/* ========== Range-compacted Counting Sort ========== */
+
+/*
+ * Key ranges wider than this fall back to radix sort: past a few counters
+ * per element the table stops fitting in cache and the prefix pass over
+ * mostly-empty counters dominates.
+ */
+#define COUNTING_MIN_TABLE (1 << 16)
+#define COUNTING_TABLE_PER_ELEMENT 2
+
+typedef struct {
+    int *arr;
+    int n;
+    int min_val;
+    int chunks;                 // Input chunks, one histogram each
+    int slices;                 // Value-range slices for merge/expansion
+    long long range;
+    unsigned int *hist;         // chunks x range
+    int *chunk_min;
+    int *chunk_max;
+    long long *slice_start;     // Output position of each value slice
+} CountingContext;
+
+static inline long long chunk_bound(long long total, int parts, int index) {
+    return total * index / parts;
+}
+
+static void min_max_task(ThreadPool *pool, void *arg, int chunk, int unused) {
+    (void)pool;
+    (void)unused;
+    CountingContext *ctx = (CountingContext *)arg;
+    int begin = (int)chunk_bound(ctx->n, ctx->chunks, chunk);
+    int end = (int)chunk_bound(ctx->n, ctx->chunks, chunk + 1);
+    int lo = ctx->arr[begin];
+    int hi = ctx->arr[begin];
+    for (int i = begin + 1; i < end; i++) {
+        int value = ctx->arr[i];
+        lo = value < lo ? value : lo;
+        hi = value > hi ? value : hi;
+    }
+    SORT_READS(end - begin);
+    SORT_COMPARES(2 * (end - begin - 1));
+    ctx->chunk_min[chunk] = lo;
+    ctx->chunk_max[chunk] = hi;
+}
+
+static void histogram_task(ThreadPool *pool, void *arg, int chunk, int unused) {
+    (void)pool;
+    (void)unused;
+    CountingContext *ctx = (CountingContext *)arg;
+    int begin = (int)chunk_bound(ctx->n, ctx->chunks, chunk);
+    int end = (int)chunk_bound(ctx->n, ctx->chunks, chunk + 1);
+    unsigned int *hist = ctx->hist + (size_t)chunk * ctx->range;
+    memset(hist, 0, (size_t)ctx->range * sizeof(unsigned int));
+    for (int i = begin; i < end; i++) {
+        hist[(unsigned int)ctx->arr[i] - (unsigned int)ctx->min_val]++;
+    }
+    SORT_READS(end - begin);
+}
+
+// Fold every chunk's counters for one value slice into chunk 0's table
+static void merge_slice_task(ThreadPool *pool, void *arg, int slice, int unused) {
+    (void)pool;
+    (void)unused;
+    CountingContext *ctx = (CountingContext *)arg;
+    long long begin = chunk_bound(ctx->range, ctx->slices, slice);
+    long long end = chunk_bound(ctx->range, ctx->slices, slice + 1);
+    long long total = 0;
+    for (long long v = begin; v < end; v++) {
+        unsigned int count = ctx->hist[v];
+        for (int c = 1; c < ctx->chunks; c++) {
+            count += ctx->hist[(size_t)c * ctx->range + v];
+        }
+        ctx->hist[v] = count;
+        total += count;
+    }
+    ctx->slice_start[slice + 1] = total;
+}
+
+// No payload to carry, so the output is rebuilt straight from the counters
+static void expand_slice_task(ThreadPool *pool, void *arg, int slice, int unused) {
+    (void)pool;
+    (void)unused;
+    CountingContext *ctx = (CountingContext *)arg;
+    long long begin = chunk_bound(ctx->range, ctx->slices, slice);
+    long long end = chunk_bound(ctx->range, ctx->slices, slice + 1);
+    int *out = ctx->arr + ctx->slice_start[slice];
+    for (long long v = begin; v < end; v++) {
+        int value = (int)(ctx->min_val + v);
+        for (unsigned int k = ctx->hist[v]; k > 0; k--) {
+            *out++ = value;
+        }
+    }
+    SORT_WRITES(out - (ctx->arr + ctx->slice_start[slice]));
+}
+
+/*
+ * Serial engine with the narrowest counter type that cannot overflow for n
+ * elements; smaller tables keep more of the range in cache.
+ */
+#define DEFINE_SERIAL_COUNTING(suffix, counter_t)                             \
+    static bool counting_serial_##suffix(int *arr, int n, int min_val,        \
+                                         long long range) {                   \
+        counter_t *count = (counter_t *)sort_calloc((size_t)range, sizeof(counter_t)); \
+        if (count == NULL) {                                                  \
+            return false;                                                     \
+        }                                                                     \
+        for (int i = 0; i < n; i++) {                                         \
+            count[(unsigned int)arr[i] - (unsigned int)min_val]++;            \
+        }                                                                     \
+        SORT_READS(n);                                                        \
+        SORT_WRITES(n);                                                       \
+        int *out = arr;                                                       \
+        for (long long v = 0; v < range; v++) {                               \
+            int value = (int)(min_val + v);                                   \
+            for (counter_t k = count[v]; k > 0; k--) {                        \
+                *out++ = value;                                               \
+            }                                                                 \
+        }                                                                     \
+        sort_free(count);                                                     \
+        return true;                                                          \
+    }
+
+DEFINE_SERIAL_COUNTING(u8, uint8_t)
+DEFINE_SERIAL_COUNTING(u16, uint16_t)
+DEFINE_SERIAL_COUNTING(u32, uint32_t)
+
+static bool counting_parallel(CountingContext *ctx, ThreadPool *pool, int threads) {
+    // Per-chunk tables cost chunks x range counters: keep that within ~n
+    long long max_chunks = ctx->n / ctx->range;
+    ctx->chunks = max_chunks < threads ? (int)(max_chunks > 0 ? max_chunks : 1) : threads;
+    ctx->slices = threads;
+    ctx->hist = (unsigned int *)sort_malloc((size_t)ctx->chunks * ctx->range * sizeof(unsigned int));
+    ctx->slice_start = (long long *)sort_calloc((size_t)ctx->slices + 1, sizeof(long long));
+    if (ctx->hist == NULL || ctx->slice_start == NULL) {
+        sort_free(ctx->hist);
+        sort_free(ctx->slice_start);
+        return false;
+    }
+
+    thread_pool_parallel_for(pool, ctx->chunks, histogram_task, ctx);
+    thread_pool_parallel_for(pool, ctx->slices, merge_slice_task, ctx);
+    for (int s = 0; s < ctx->slices; s++) {
+        ctx->slice_start[s + 1] += ctx->slice_start[s];
+    }
+    thread_pool_parallel_for(pool, ctx->slices, expand_slice_task, ctx);
+
+    sort_free(ctx->hist);
+    sort_free(ctx->slice_start);
+    return true;
+}
+
+void counting_sort_range(int *arr, int n, int threads) {
+    if (arr == NULL || n <= 1) {
+        return;
+    }
+    // Below the cutoff the parallel phases cost more than they save
+    if (threads < 1 || n < sort_tuning_get(TUNE_PARALLEL_COUNTING_CUTOFF)) {
+        threads = 1;
+    }
+
+    CountingContext ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.arr = arr;
+    ctx.n = n;
+    ctx.chunks = threads;
+
+    ThreadPool *pool = threads > 1 ? thread_pool_create(threads) : NULL;
+    int chunk_min_local;
+    int chunk_max_local;
+    if (pool != NULL) {
+        ctx.chunk_min = (int *)sort_malloc((size_t)threads * sizeof(int));
+        ctx.chunk_max = (int *)sort_malloc((size_t)threads * sizeof(int));
+        if (ctx.chunk_min == NULL || ctx.chunk_max == NULL) {
+            sort_free(ctx.chunk_min);
+            sort_free(ctx.chunk_max);
+            thread_pool_destroy(pool);
+            pool = NULL;
+        }
+    }
+    if (pool == NULL) {
+        threads = 1;
+        ctx.chunks = 1;
+        ctx.chunk_min = &chunk_min_local;
+        ctx.chunk_max = &chunk_max_local;
+        min_max_task(NULL, &ctx, 0, 0);
+    } else {
+        thread_pool_parallel_for(pool, threads, min_max_task, &ctx);
+    }
+
+    int min_val = ctx.chunk_min[0];
+    int max_val = ctx.chunk_max[0];
+    for (int c = 1; c < ctx.chunks; c++) {
+        min_val = ctx.chunk_min[c] < min_val ? ctx.chunk_min[c] : min_val;
+        max_val = ctx.chunk_max[c] > max_val ? ctx.chunk_max[c] : max_val;
+    }
+    if (pool != NULL) {
+        sort_free(ctx.chunk_min);
+        sort_free(ctx.chunk_max);
+    }
+
+    ctx.min_val = min_val;
+    ctx.range = (long long)max_val - min_val + 1;
+
+    long long table_limit = (long long)n * COUNTING_TABLE_PER_ELEMENT;
+    if (table_limit < COUNTING_MIN_TABLE) {
+        table_limit = COUNTING_MIN_TABLE;
+    }
+
+    bool done = false;
+    if (ctx.range == 1) {
+        done = true;
+    } else if (ctx.range <= table_limit) {
+        if (pool != NULL) {
+            done = counting_parallel(&ctx, pool, threads);
+        } else if (n <= UINT8_MAX) {
+            done = counting_serial_u8(arr, n, min_val, ctx.range);
+        } else if (n <= UINT16_MAX) {
+            done = counting_serial_u16(arr, n, min_val, ctx.range);
+        } else {
+            done = counting_serial_u32(arr, n, min_val, ctx.range);
+        }
+    }
+
+    thread_pool_destroy(pool);
+
+    if (!done) {
+        // Sparse keys: a table proportional to the range would dwarf the data
+        radix_sort_bits(arr, n, 8, threads);
+    }
 }
@@ -1,15 +1,16 @@
 #include <stdlib.h>
 #include "../../include/sorts.h"
+#include "../../include/sort_instrument.h"
 
 static void heapify(int *arr, int n, int i) {
     int largest = i;
     int left = 2 * i + 1;
     int right = 2 * i + 2;
 
-    if (left < n && arr[left] > arr[largest]) {
+    if (left < n && SORT_CMP(2, arr[left] > arr[largest])) {
         largest = left;
     }
-    if (right < n && arr[right] > arr[largest]) {
+    if (right < n && SORT_CMP(2, arr[right] > arr[largest])) {
         largest = right;
     }
 
@@ -17,6 +18,7 @@ static void heapify(int *arr, int n, int i) {
         int temp = arr[i];
         arr[i] = arr[largest];
         arr[largest] = temp;
+        SORT_SWAPS(1);
         heapify(arr, n, largest);
     }
 }
@@ -34,6 +36,92 @@ void heap_sort(int *arr, int n) {
         int temp = arr[0];
         arr[0] = arr[i];
         arr[i] = temp;
+        SORT_SWAPS(1);
         heapify(arr, i, 0);
     }
 }
+
+/* ========== d-ary Heap Sort (bottom-up Floyd sift) ========== */
+
+// Prefetch the children of every child of `hole`: d * d consecutive slots
+static inline void prefetch_grandchildren(const int *arr, int n, int first_child, int arity) {
+    long long begin = (long long)arity * first_child + 1;
+    if (begin >= n) {
+        return;
+    }
+    long long end = begin + (long long)arity * arity;
+    if (end > n) {
+        end = n;
+    }
+    for (long long i = begin; i < end; i += 16) {  // 16 ints per 64-byte line
+        __builtin_prefetch(&arr[i]);
+    }
+    __builtin_prefetch(&arr[end - 1]);
+}
+
+/*
+ * Floyd's bottom-up sift: walk the hole at `root` down to a leaf along the
+ * largest child (d - 1 comparisons per level, none against `value`), then
+ * sift `value` back up from there. Most values belong near the leaves, so
+ * the climb is short.
+ */
+static void sift_down_floyd(int *arr, int n, int root, int arity, int value) {
+    int hole = root;
+    for (;;) {
+        long long first_ll = (long long)arity * hole + 1;
+        if (first_ll >= n) {
+            break;
+        }
+        int first = (int)first_ll;
+        int last = n - first < arity ? n : first + arity;
+        prefetch_grandchildren(arr, n, first, arity);
+
+        // Track the running max in registers so the compiler emits cmovs
+        int best = first;
+        int best_value = arr[first];
+        for (int c = first + 1; c < last; c++) {
+            int child = arr[c];
+            best = child > best_value ? c : best;
+            best_value = child > best_value ? child : best_value;
+        }
+        arr[hole] = best_value;
+        SORT_COMPARES(last - first - 1);
+        SORT_READS(last - first);
+        SORT_WRITES(1);
+        hole = best;
+    }
+
+    while (hole > root) {
+        int parent = (hole - 1) / arity;
+        if (SORT_CMP(1, arr[parent] >= value)) {
+            break;
+        }
+        arr[hole] = arr[parent];
+        SORT_MOVES(1);
+        hole = parent;
+    }
+    arr[hole] = value;
+    SORT_WRITES(1);
+}
+
+void heap_sort_dary(int *arr, int n, int arity) {
+    if (arr == NULL || n <= 1) {
+        return;
+    }
+    if (arity != 2 && arity != 4 && arity != 8) {
+        arity = 4;
+    }
+
+    for (int i = (n - 2) / arity; i >= 0; i--) {
+        SORT_READS(1);
+        sift_down_floyd(arr, n, i, arity, arr[i]);
+    }
+
+    for (int end = n - 1; end > 0; end--) {
+        int value = arr[end];
+        arr[end] = arr[0];
+        SORT_READS(1);
+        SORT_MOVES(1);
+        sift_down_floyd(arr, end, 0, arity, value);
+    }
+}
@@ -1,13 +1,17 @@
 #include "../../include/sorts.h"
+#include "../../include/sort_instrument.h"
 
 void insertion_sort(int *arr, int n) {
     for (int i = 1; i < n; i++) {
         int key = arr[i];
         int j = i - 1;
-        while (j >= 0 && arr[j] > key) {
+        SORT_READS(1);
+        while (j >= 0 && SORT_CMP(1, arr[j] > key)) {
             arr[j + 1] = arr[j];
+            SORT_MOVES(1);
             j--;
         }
         arr[j + 1] = key;
+        SORT_WRITES(1);
     }
 }
@@ -0,0 +1,39 @@
+#include <string.h>
+#include "../../include/sort_instrument.h"
+#include "../../include/sort_alloc.h"
+
+#ifdef SORT_INSTRUMENT
+
+SortStats sort_counters;
+
+bool sort_stats_enabled(void) {
+    return true;
+}
+
+void sort_stats_reset(void) {
+    memset(&sort_counters, 0, sizeof(sort_counters));
+    sort_alloc_reset();
+}
+
+SortStats sort_stats_read(void) {
+    SortStats stats = sort_counters;
+    stats.aux_bytes = sort_alloc_read().peak_bytes;
+    return stats;
+}
+
+#else
+
+bool sort_stats_enabled(void) {
+    return false;
+}
+
+void sort_stats_reset(void) {
+}
+
+SortStats sort_stats_read(void) {
+    SortStats stats;
+    memset(&stats, 0, sizeof(stats));
+    return stats;
+}
+
+#endif
@@ -0,0 +1,234 @@
+#include <stdbool.h>
+#include <stdlib.h>
+#include "../../include/sorts.h"
+#include "../../include/sort_tuning.h"
+
+// Slices above this size use Tukey's ninther instead of median-of-3
+#define INTRO_NINTHER_THRESHOLD 128
+// Element moves a partial insertion sort may make before giving up
+#define INTRO_PARTIAL_INSERTION_LIMIT 8
+
+static void swap(int *a, int *b) {
+    int temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+// Order arr[a] <= arr[b] <= arr[c]
+static void sort3(int *arr, int a, int b, int c) {
+    if (arr[b] < arr[a]) {
+        swap(&arr[a], &arr[b]);
+    }
+    if (arr[c] < arr[b]) {
+        swap(&arr[b], &arr[c]);
+    }
+    if (arr[b] < arr[a]) {
+        swap(&arr[a], &arr[b]);
+    }
+}
+
+static int floor_log2(int n) {
+    int log = 0;
+    while (n > 1) {
+        n >>= 1;
+        log++;
+    }
+    return log;
+}
+
+/*
+ * Finish [begin, end) in one linear scan if it is already ascending, or
+ * reverse it if it is descending. Returns false (leaving the slice untouched)
+ * as soon as the scan finds an element out of order.
+ */
+static bool finish_monotonic(int *arr, int begin, int end) {
+    if (arr[begin] <= arr[end - 1]) {
+        for (int i = begin + 1; i < end; i++) {
+            if (arr[i - 1] > arr[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    for (int i = begin + 1; i < end; i++) {
+        if (arr[i - 1] < arr[i]) {
+            return false;
+        }
+    }
+    for (int i = begin, j = end - 1; i < j; i++, j--) {
+        swap(&arr[i], &arr[j]);
+    }
+    return true;
+}
+
+/*
+ * Insertion sort that bails out after INTRO_PARTIAL_INSERTION_LIMIT moves.
+ * Returns true if [begin, end) ended up sorted.
+ */
+static bool partial_insertion_sort(int *arr, int begin, int end) {
+    int moves = 0;
+    for (int cur = begin + 1; cur < end; cur++) {
+        int value = arr[cur];
+        int j = cur;
+        if (arr[j - 1] > value) {
+            do {
+                arr[j] = arr[j - 1];
+                j--;
+            } while (j > begin && arr[j - 1] > value);
+            arr[j] = value;
+            moves += cur - j;
+        }
+        if (moves > INTRO_PARTIAL_INSERTION_LIMIT) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Hoare-style partition around arr[begin]: elements < pivot end up left of
+ * the returned position, elements >= pivot right of it. Pivot selection
+ * guarantees an element >= pivot to the right, which bounds the first scan.
+ */
+static int partition_right(int *arr, int begin, int end, bool *already_partitioned) {
+    int pivot = arr[begin];
+    int first = begin;
+    int last = end;
+
+    while (arr[++first] < pivot) {
+    }
+    if (first - 1 == begin) {
+        while (first < last && !(arr[--last] < pivot)) {
+        }
+    } else {
+        while (!(arr[--last] < pivot)) {
+        }
+    }
+
+    *already_partitioned = first >= last;
+
+    while (first < last) {
+        swap(&arr[first], &arr[last]);
+        while (arr[++first] < pivot) {
+        }
+        while (!(arr[--last] < pivot)) {
+        }
+    }
+
+    int pivot_pos = first - 1;
+    arr[begin] = arr[pivot_pos];
+    arr[pivot_pos] = pivot;
+    return pivot_pos;
+}
+
+/*
+ * Mirror of partition_right that puts elements equal to the pivot on the
+ * left. Used when the pivot equals the element before the slice, i.e. every
+ * key equal to it is already in its final region.
+ */
+static int partition_left(int *arr, int begin, int end) {
+    int pivot = arr[begin];
+    int first = begin;
+    int last = end;
+
+    while (pivot < arr[--last]) {
+    }
+    if (last + 1 == end) {
+        while (first < last && !(pivot < arr[++first])) {
+        }
+    } else {
+        while (!(pivot < arr[++first])) {
+        }
+    }
+
+    while (first < last) {
+        swap(&arr[first], &arr[last]);
+        while (pivot < arr[--last]) {
+        }
+        while (!(pivot < arr[++first])) {
+        }
+    }
+
+    arr[begin] = arr[last];
+    arr[last] = pivot;
+    return last;
+}
+
+// Slices below insertion_threshold go straight to insertion sort
+static void intro_sort_loop(int *arr, int begin, int end, int depth_limit, bool leftmost,
+                            int insertion_threshold) {
+    for (;;) {
+        int size = end - begin;
+        if (size < insertion_threshold) {
+            insertion_sort(arr + begin, size);
+            return;
+        }
+        if (depth_limit == 0) {
+            heap_sort(arr + begin, size);
+            return;
+        }
+        depth_limit--;
+
+        int s2 = size / 2;
+
+        // Samples already in order hint at a sorted or reversed run
+        bool ascending = arr[begin] <= arr[begin + s2] && arr[begin + s2] <= arr[end - 1];
+        bool descending = arr[begin] >= arr[begin + s2] && arr[begin + s2] >= arr[end - 1];
+        if ((ascending || descending) && finish_monotonic(arr, begin, end)) {
+            return;
+        }
+
+        if (size > INTRO_NINTHER_THRESHOLD) {
+            sort3(arr, begin, begin + s2, end - 1);
+            sort3(arr, begin + 1, begin + s2 - 1, end - 2);
+            sort3(arr, begin + 2, begin + s2 + 1, end - 3);
+            sort3(arr, begin + s2 - 1, begin + s2, begin + s2 + 1);
+            swap(&arr[begin], &arr[begin + s2]);
+        } else {
+            sort3(arr, begin + s2, begin, end - 1);
+        }
+
+        // Pivot equal to the left neighbour: the equal keys are already placed
+        if (!leftmost && !(arr[begin - 1] < arr[begin])) {
+            begin = partition_left(arr, begin, end) + 1;
+            continue;
+        }
+
+        bool already_partitioned;
+        int pivot_pos = partition_right(arr, begin, end, &already_partitioned);
+
+        if (already_partitioned) {
+            bool left_sorted = partial_insertion_sort(arr, begin, pivot_pos);
+            if (partial_insertion_sort(arr, pivot_pos + 1, end)) {
+                if (left_sorted) {
+                    return;
+                }
+                end = pivot_pos;
+                continue;
+            }
+            if (left_sorted) {
+                begin = pivot_pos + 1;
+                leftmost = false;
+                continue;
+            }
+        }
+
+        // Recurse into the smaller side, iterate on the larger
+        if (pivot_pos - begin < end - pivot_pos - 1) {
+            intro_sort_loop(arr, begin, pivot_pos, depth_limit, leftmost, insertion_threshold);
+            begin = pivot_pos + 1;
+            leftmost = false;
+        } else {
+            intro_sort_loop(arr, pivot_pos + 1, end, depth_limit, false, insertion_threshold);
+            end = pivot_pos;
+        }
+    }
+}
+
+void intro_sort(int *arr, int n) {
+    if (arr == NULL || n <= 1) {
+        return;
+    }
+    intro_sort_loop(arr, 0, n, 2 * floor_log2(n), true, sort_tuning_get(TUNE_INTRO_INSERTION));
+}
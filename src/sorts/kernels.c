@@ -0,0 +1,272 @@
+#include <limits.h>
+#include <stdbool.h>
+#include <string.h>
+#include "../../include/sorts.h"
+#include "../../include/sort_kernels.h"
+#include "../../include/sort_instrument.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SORT_KERNELS_X86 1
+#include <immintrin.h>
+#include <pthread.h>
+#endif
+
+/* ========== Scalar fallbacks ========== */
+
+static void merge_scalar(const int *a, int m, const int *b, int l, int *out) {
+    int i = 0, j = 0, k = 0;
+    while (i < m && j < l) {
+        if (SORT_CMP(2, a[i] <= b[j])) {
+            out[k++] = a[i++];
+        } else {
+            out[k++] = b[j++];
+        }
+    }
+    while (i < m) {
+        out[k++] = a[i++];
+    }
+    while (j < l) {
+        out[k++] = b[j++];
+    }
+    SORT_MOVES(m + l);
+}
+
+#ifdef SORT_KERNELS_X86
+
+/* ========== AVX2 bitonic networks ========== */
+
+#define AVX2_KERNEL __attribute__((target("avx2")))
+
+/*
+ * Compare-exchange every lane with its partner in `partner`; lanes whose bit
+ * is set in `max_lanes` keep the larger value. The blend mask must be an
+ * immediate, hence the macro. One call is 4 comparators.
+ */
+#define COMPARE_EXCHANGE(v, partner, max_lanes)                               \
+    _mm256_blend_epi32(_mm256_min_epi32((v), (partner)),                      \
+                       _mm256_max_epi32((v), (partner)), (max_lanes))
+
+static inline AVX2_KERNEL __m256i swap_halves(__m256i v) {
+    return _mm256_permute2x128_si256(v, v, 0x01);
+}
+
+static inline AVX2_KERNEL __m256i reverse_lanes(__m256i v) {
+    return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+// Sort one register that holds a bitonic sequence (lane distances 4, 2, 1)
+static inline AVX2_KERNEL __m256i bitonic_merge_8(__m256i v) {
+    SORT_COMPARES(12);
+    v = COMPARE_EXCHANGE(v, swap_halves(v), 0xF0);
+    v = COMPARE_EXCHANGE(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)), 0xCC);
+    v = COMPARE_EXCHANGE(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)), 0xAA);
+    return v;
+}
+
+// Full bitonic sort of the 8 lanes of one register
+static inline AVX2_KERNEL __m256i sort_8(__m256i v) {
+    SORT_COMPARES(12);
+    // Pairs: alternating ascending/descending
+    v = COMPARE_EXCHANGE(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)), 0x66);
+    // Quads: lanes 0-3 ascending, 4-7 descending
+    v = COMPARE_EXCHANGE(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)), 0x3C);
+    v = COMPARE_EXCHANGE(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)), 0x5A);
+    return bitonic_merge_8(v);
+}
+
+/*
+ * v[0, count) holds two sorted halves of count / 2 registers each.
+ * Reversing the second half makes the whole sequence bitonic; register-level
+ * half cleaners then bring it down to per-register bitonic merges.
+ */
+static inline AVX2_KERNEL void merge_registers(__m256i *v, int count) {
+    int half = count / 2;
+    for (int i = 0; i < half; i++) {
+        __m256i lo = v[i];
+        __m256i hi = reverse_lanes(v[count - 1 - i]);
+        v[i] = _mm256_min_epi32(lo, hi);
+        // Stored mirrored; a reversed bitonic sequence is still bitonic
+        v[count - 1 - i] = reverse_lanes(_mm256_max_epi32(lo, hi));
+    }
+    SORT_COMPARES(8 * half);
+    // Both halves are now bitonic with every low element <= every high one
+    for (int dist = half / 2; dist > 0; dist /= 2) {
+        for (int i = 0; i < count; i++) {
+            if ((i & dist) == 0) {
+                __m256i lo = v[i];
+                __m256i hi = v[i + dist];
+                v[i] = _mm256_min_epi32(lo, hi);
+                v[i + dist] = _mm256_max_epi32(lo, hi);
+            }
+        }
+        SORT_COMPARES(8 * half);
+    }
+    for (int i = 0; i < count; i++) {
+        v[i] = bitonic_merge_8(v[i]);
+    }
+}
+
+static AVX2_KERNEL void small_sort_avx2(int *arr, int n) {
+    int registers = 1;
+    while (registers * 8 < n) {
+        registers *= 2;
+    }
+
+    // Pad the block to a whole network with INT_MAX so it sorts to the tail
+    int block[SORT_KERNEL_MAX];
+    memcpy(block, arr, (size_t)n * sizeof(int));
+    for (int i = n; i < registers * 8; i++) {
+        block[i] = INT_MAX;
+    }
+    SORT_MOVES(n);
+    SORT_WRITES(registers * 8 - n);
+    SORT_READS(registers * 8);
+
+    __m256i v[SORT_KERNEL_MAX / 8];
+    for (int r = 0; r < registers; r++) {
+        v[r] = sort_8(_mm256_loadu_si256((const __m256i *)(block + 8 * r)));
+    }
+    for (int width = 2; width <= registers; width *= 2) {
+        for (int r = 0; r < registers; r += width) {
+            merge_registers(v + r, width);
+        }
+    }
+
+    for (int r = 0; r < registers; r++) {
+        _mm256_storeu_si256((__m256i *)(block + 8 * r), v[r]);
+    }
+    memcpy(arr, block, (size_t)n * sizeof(int));
+    SORT_WRITES(registers * 8);
+    SORT_MOVES(n);
+}
+
+/*
+ * Vectorized 2-way merge: keep 8 pending elements in a register, merge them
+ * with the next 8-block of whichever input has the smaller head, emit the
+ * lower half. Tails shorter than a block finish with a scalar 3-way merge.
+ */
+static AVX2_KERNEL void merge_avx2(const int *a, int m, const int *b, int l, int *out) {
+    if (m < 8 || l < 8) {
+        merge_scalar(a, m, b, l, out);
+        return;
+    }
+
+    __m256i pending = _mm256_loadu_si256((const __m256i *)a);
+    __m256i next = _mm256_loadu_si256((const __m256i *)b);
+    int i = 8, j = 8;
+    SORT_READS(16);
+
+    for (;;) {
+        __m256i reversed = reverse_lanes(next);
+        __m256i lo = bitonic_merge_8(_mm256_min_epi32(pending, reversed));
+        pending = bitonic_merge_8(_mm256_max_epi32(pending, reversed));
+        _mm256_storeu_si256((__m256i *)out, lo);
+        out += 8;
+        SORT_COMPARES(8);
+        SORT_WRITES(8);
+
+        bool take_a;
+        if (i < m && j < l) {
+            take_a = SORT_CMP(2, a[i] <= b[j]);
+        } else if (i < m || j < l) {
+            take_a = i < m;
+        } else {
+            break;
+        }
+
+        if (take_a) {
+            if (i + 8 > m) {
+                break;
+            }
+            next = _mm256_loadu_si256((const __m256i *)(a + i));
+            SORT_READS(8);
+            i += 8;
+        } else {
+            if (j + 8 > l) {
+                break;
+            }
+            next = _mm256_loadu_si256((const __m256i *)(b + j));
+            SORT_READS(8);
+            j += 8;
+        }
+    }
+
+    int rest[8];
+    _mm256_storeu_si256((__m256i *)rest, pending);
+    SORT_WRITES(8);
+
+    int r = 0;
+    while (r < 8 || i < m || j < l) {
+        int pick = 0;  // 0: rest, 1: a, 2: b
+        int best = INT_MAX;
+        bool found = false;
+        if (r < 8) {
+            best = rest[r];
+            found = true;
+        }
+        if (i < m && (!found || SORT_CMP(1, a[i] < best))) {
+            best = a[i];
+            pick = 1;
+            found = true;
+        }
+        if (j < l && (!found || SORT_CMP(1, b[j] < best))) {
+            best = b[j];
+            pick = 2;
+        }
+        *out++ = best;
+        SORT_MOVES(1);
+        if (pick == 0) {
+            r++;
+        } else if (pick == 1) {
+            i++;
+        } else {
+            j++;
+        }
+    }
+}
+
+static bool simd_supported;
+
+// Probed once, before the first kernel call from any thread
+static pthread_once_t simd_once = PTHREAD_ONCE_INIT;
+
+static void probe_simd(void) {
+    __builtin_cpu_init();
+    simd_supported = __builtin_cpu_supports("avx2");
+}
+
+bool sort_kernels_use_simd(void) {
+    pthread_once(&simd_once, probe_simd);
+    return simd_supported;
+}
+
+#else
+
+bool sort_kernels_use_simd(void) {
+    return false;
+}
+
+#endif
+
+void small_sort(int *arr, int n) {
+    if (n <= 1) {
+        return;
+    }
+#ifdef SORT_KERNELS_X86
+    if (n <= SORT_KERNEL_MAX && sort_kernels_use_simd()) {
+        small_sort_avx2(arr, n);
+        return;
+    }
+#endif
+    insertion_sort(arr, n);
+}
+
+void merge_kernel(const int *a, int m, const int *b, int l, int *out) {
+#ifdef SORT_KERNELS_X86
+    if (sort_kernels_use_simd()) {
+        merge_avx2(a, m, b, l, out);
+        return;
+    }
+#endif
+    merge_scalar(a, m, b, l, out);
+}
@@ -1,16 +1,22 @@
 #include <stdlib.h>
+#include <string.h>
 #include "../../include/sorts.h"
+#include "../../include/sort_alloc.h"
+#include "../../include/sort_kernels.h"
+#include "../../include/sort_instrument.h"
+#include "../../include/sort_tuning.h"
+#include "../../include/thread_pool.h"
 
 static void merge(int *arr, int left, int mid, int right) {
     int n1 = mid - left + 1;
     int n2 = right - mid;
 
-    int *left_arr = (int *)malloc(n1 * sizeof(int));
-    int *right_arr = (int *)malloc(n2 * sizeof(int));
+    int *left_arr = (int *)sort_malloc(n1 * sizeof(int));
+    int *right_arr = (int *)sort_malloc(n2 * sizeof(int));
 
     if (left_arr == NULL || right_arr == NULL) {
-        free(left_arr);
-        free(right_arr);
+        sort_free(left_arr);
+        sort_free(right_arr);
         return;
     }
 
@@ -20,40 +26,215 @@ static void merge(int *arr, int left, int mid, int right) {
     for (int j = 0; j < n2; j++) {
         right_arr[j] = arr[mid + 1 + j];
     }
+    SORT_MOVES(n1 + n2);
 
-    int i = 0, j = 0, k = left;
-    while (i < n1 && j < n2) {
-        if (left_arr[i] <= right_arr[j]) {
-            arr[k++] = left_arr[i++];
-        } else {
-            arr[k++] = right_arr[j++];
-        }
+    merge_kernel(left_arr, n1, right_arr, n2, arr + left);
+
+    sort_free(left_arr);
+    sort_free(right_arr);
+}
+
+// Leaf runs (both engines) of up to run_size elements are sorted by the sorting-network kernel
+static void merge_sort_recursive(int *arr, int left, int right, int run_size) {
+    if (right - left + 1 <= run_size) {
+        small_sort(arr + left, right - left + 1);
+        return;
     }
+    int mid = left + (right - left) / 2;
+    merge_sort_recursive(arr, left, mid, run_size);
+    merge_sort_recursive(arr, mid + 1, right, run_size);
+    merge(arr, left, mid, right);
+}
 
-    while (i < n1) {
-        arr[k++] = left_arr[i++];
+void merge_sort(int *arr, int n) {
+    if (arr == NULL || n <= 1) {
+        return;
     }
-    while (j < n2) {
-        arr[k++] = right_arr[j++];
+    merge_sort_recursive(arr, 0, n - 1, sort_tuning_get(TUNE_MERGE_RUN_SIZE));
+}
+
+/* ========== Bottom-up (allocation-free) Merge Sort ========== */
+
+// Sort arr[0, n) using buffer[0, n) as the ping-pong partner
+static void bottom_up_sort(int *arr, int n, int *buffer) {
+    int run_size = sort_tuning_get(TUNE_MERGE_RUN_SIZE);
+    for (int lo = 0; lo < n; lo += run_size) {
+        int len = n - lo < run_size ? n - lo : run_size;
+        small_sort(arr + lo, len);
     }
 
-    free(left_arr);
-    free(right_arr);
+    // Each level reads from one buffer and writes the other
+    int *src = arr;
+    int *dst = buffer;
+    for (int width = run_size; width < n; width *= 2) {
+        for (int lo = 0; lo < n; lo += 2 * width) {
+            int mid = lo + width < n ? lo + width : n;
+            int hi = lo + 2 * width < n ? lo + 2 * width : n;
+            merge_kernel(src + lo, mid - lo, src + mid, hi - mid, dst + lo);
+        }
+        int *next_src = dst;
+        dst = src;
+        src = next_src;
+    }
+
+    if (src != arr) {
+        memcpy(arr, src, (size_t)n * sizeof(int));
+        SORT_MOVES(n);
+    }
 }
 
-static void merge_sort_recursive(int *arr, int left, int right) {
-    if (left >= right) {
+void merge_sort_bottom_up(int *arr, int n) {
+    if (arr == NULL || n <= 1) {
         return;
     }
-    int mid = left + (right - left) / 2;
-    merge_sort_recursive(arr, left, mid);
-    merge_sort_recursive(arr, mid + 1, right);
-    merge(arr, left, mid, right);
+    if (n <= sort_tuning_get(TUNE_MERGE_RUN_SIZE)) {
+        small_sort(arr, n);
+        return;
+    }
+
+    int *buffer = (int *)sort_malloc((size_t)n * sizeof(int));
+    if (buffer == NULL) {
+        return;
+    }
+    bottom_up_sort(arr, n, buffer);
+    sort_free(buffer);
 }
 
-void merge_sort(int *arr, int n) {
+/* ========== Parallel Merge Sort (merge-path partitioned merges) ========== */
+
+typedef struct {
+    int *src;
+    int *dst;
+    int n;
+    int slices;
+    int run_count;
+    int *bounds;                // run_count + 1 run boundaries into src
+} ParallelMergeContext;
+
+/*
+ * Co-rank: how many of the first k merged outputs come from a[0, m).
+ * Ties go to a, matching the stable merge loop in merge_slice_task.
+ */
+static int co_rank(int k, const int *a, int m, const int *b, int l) {
+    int lo = k > l ? k - l : 0;
+    int hi = k < m ? k : m;
+    while (lo < hi) {
+        int i = lo + (hi - lo) / 2;
+        int j = k - i;
+        if (j > 0 && i < m && a[i] <= b[j - 1]) {
+            lo = i + 1;
+        } else {
+            hi = i;
+        }
+    }
+    return lo;
+}
+
+// Each chunk is sorted on its own slice of the shared scratch buffer
+static void sort_chunk_task(ThreadPool *pool, void *arg, int chunk, int unused) {
+    (void)pool;
+    (void)unused;
+    ParallelMergeContext *ctx = (ParallelMergeContext *)arg;
+    int lo = ctx->bounds[chunk];
+    int hi = ctx->bounds[chunk + 1];
+    bottom_up_sort(ctx->src + lo, hi - lo, ctx->dst + lo);
+}
+
+/*
+ * Output slice t of the current level: [n*t/slices, n*(t+1)/slices).
+ * The slice may straddle several run pairs; each piece is located in both
+ * inputs with co_rank and merged independently of the other slices.
+ */
+static void merge_slice_task(ThreadPool *pool, void *arg, int slice, int unused) {
+    (void)pool;
+    (void)unused;
+    ParallelMergeContext *ctx = (ParallelMergeContext *)arg;
+    int out_begin = (int)((long long)ctx->n * slice / ctx->slices);
+    int out_end = (int)((long long)ctx->n * (slice + 1) / ctx->slices);
+
+    for (int r = 0; r < ctx->run_count && out_begin < out_end; r += 2) {
+        int lo = ctx->bounds[r];
+        int mid = ctx->bounds[r + 1];
+        int hi = r + 2 <= ctx->run_count ? ctx->bounds[r + 2] : mid;
+        if (hi <= out_begin) {
+            continue;
+        }
+
+        int seg_end = hi < out_end ? hi : out_end;
+        const int *a = ctx->src + lo;
+        const int *b = ctx->src + mid;
+        int m = mid - lo;
+        int l = hi - mid;
+        int i = co_rank(out_begin - lo, a, m, b, l);
+        int j = out_begin - lo - i;
+
+        int *out = ctx->dst + out_begin;
+        for (int k = out_begin; k < seg_end; k++) {
+            if (j >= l || (i < m && a[i] <= b[j])) {
+                *out++ = a[i++];
+            } else {
+                *out++ = b[j++];
+            }
+        }
+        out_begin = seg_end;
+    }
+}
+
+void parallel_merge_sort(int *arr, int n, int threads) {
     if (arr == NULL || n <= 1) {
         return;
     }
-    merge_sort_recursive(arr, 0, n - 1);
+    // Below the cutoff the parallel engine defers to the bottom-up one
+    if (threads <= 1 || n < sort_tuning_get(TUNE_PARALLEL_MERGE_CUTOFF)) {
+        merge_sort_bottom_up(arr, n);
+        return;
+    }
+
+    int *buffer = (int *)sort_malloc((size_t)n * sizeof(int));
+    int *bounds = (int *)sort_malloc((size_t)(threads + 1) * sizeof(int));
+    ThreadPool *pool = thread_pool_create(threads);
+    if (buffer == NULL || bounds == NULL || pool == NULL) {
+        sort_free(buffer);
+        sort_free(bounds);
+        thread_pool_destroy(pool);
+        merge_sort_bottom_up(arr, n);
+        return;
+    }
+
+    ParallelMergeContext ctx;
+    ctx.src = arr;
+    ctx.dst = buffer;
+    ctx.n = n;
+    ctx.slices = threads;
+    ctx.run_count = threads;
+    ctx.bounds = bounds;
+    for (int c = 0; c <= threads; c++) {
+        bounds[c] = (int)((long long)n * c / threads);
+    }
+
+    thread_pool_parallel_for(pool, threads, sort_chunk_task, &ctx);
+
+    // Every level, all threads cooperate on all pairs, including the final merge
+    while (ctx.run_count > 1) {
+        thread_pool_parallel_for(pool, ctx.slices, merge_slice_task, &ctx);
+
+        int merged = 0;
+        for (int r = 0; r < ctx.run_count; r += 2) {
+            bounds[merged++] = bounds[r];
+        }
+        bounds[merged] = n;
+        ctx.run_count = merged;
+
+        int *next_src = ctx.dst;
+        ctx.dst = ctx.src;
+        ctx.src = next_src;
+    }
+
+    if (ctx.src != arr) {
+        memcpy(arr, ctx.src, (size_t)n * sizeof(int));
+    }
+
+    thread_pool_destroy(pool);
+    sort_free(buffer);
+    sort_free(bounds);
 }
@@ -1,20 +1,46 @@
 #include <stdlib.h>
 #include "../../include/sorts.h"
+#include "../../include/sort_kernels.h"
+#include "../../include/sort_instrument.h"
+#include "../../include/sort_tuning.h"
+#include "../../include/thread_pool.h"
+
+// Indices classified per block by the block partition (offsets fit in a byte)
+#define QUICK_BLOCK_SIZE 128
+
+typedef int (*PartitionFn)(int *arr, int low, int high, unsigned int *seed);
 
 static void swap(int *a, int *b) {
     int temp = *a;
     *a = *b;
     *b = temp;
+    SORT_SWAPS(1);
+}
+
+// xorshift32: a per-call pivot generator so parallel tasks don't contend on rand()
+static unsigned int next_random(unsigned int *state) {
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
 }
 
-static int partition(int *arr, int low, int high) {
-    int pivot_index = low + rand() % (high - low + 1);
-    int pivot_value = arr[pivot_index];
+// Move a random element to arr[high] and return its value
+static int choose_pivot(int *arr, int low, int high, unsigned int *seed) {
+    int pivot_index = low + (int)(next_random(seed) % (unsigned int)(high - low + 1));
     swap(&arr[pivot_index], &arr[high]);
+    SORT_READS(1);
+    return arr[high];
+}
+
+static int partition(int *arr, int low, int high, unsigned int *seed) {
+    int pivot_value = choose_pivot(arr, low, high, seed);
 
     int i = low - 1;
     for (int j = low; j < high; j++) {
-        if (arr[j] <= pivot_value) {
+        if (SORT_CMP(1, arr[j] <= pivot_value)) {
             i++;
             swap(&arr[i], &arr[j]);
         }
@@ -23,22 +49,149 @@ static int partition(int *arr, int low, int high) {
     return i + 1;
 }
 
-static void quick_sort_recursive(int *arr, int low, int high) {
-    while (low < high) {
-        int pivot = partition(arr, low, high);
+/*
+ * BlockQuicksort partition (Edelkamp & Weiss). The comparison results for a
+ * block of QUICK_BLOCK_SIZE indices from each end are written into offset
+ * buffers without branching; misplaced pairs are then swapped in one batch.
+ * Whatever is left between the two block cursors (< 2 blocks) is finished
+ * with a scalar loop.
+ */
+static int partition_block(int *arr, int low, int high, unsigned int *seed) {
+    int pivot_value = choose_pivot(arr, low, high, seed);
+
+    unsigned char offsets_l[QUICK_BLOCK_SIZE];
+    unsigned char offsets_r[QUICK_BLOCK_SIZE];
+    int num_l = 0, num_r = 0;
+    int start_l = 0, start_r = 0;
+    int l = low;
+    int r = high - 1;
+
+    // Invariant: arr[low, l) < pivot and arr(r, high) >= pivot
+    while (r - l + 1 > 2 * QUICK_BLOCK_SIZE) {
+        if (num_l == 0) {
+            start_l = 0;
+            for (int i = 0; i < QUICK_BLOCK_SIZE; i++) {
+                offsets_l[num_l] = (unsigned char)i;
+                num_l += arr[l + i] >= pivot_value;
+            }
+            SORT_COMPARES(QUICK_BLOCK_SIZE);
+            SORT_READS(QUICK_BLOCK_SIZE);
+        }
+        if (num_r == 0) {
+            start_r = 0;
+            for (int i = 0; i < QUICK_BLOCK_SIZE; i++) {
+                offsets_r[num_r] = (unsigned char)i;
+                num_r += arr[r - i] < pivot_value;
+            }
+            SORT_COMPARES(QUICK_BLOCK_SIZE);
+            SORT_READS(QUICK_BLOCK_SIZE);
+        }
+
+        int num = num_l < num_r ? num_l : num_r;
+        for (int k = 0; k < num; k++) {
+            swap(&arr[l + offsets_l[start_l + k]], &arr[r - offsets_r[start_r + k]]);
+        }
+
+        num_l -= num;
+        num_r -= num;
+        start_l += num;
+        start_r += num;
+        if (num_l == 0) {
+            l += QUICK_BLOCK_SIZE;
+        }
+        if (num_r == 0) {
+            r -= QUICK_BLOCK_SIZE;
+        }
+    }
+
+    int i = l;
+    for (int j = l; j <= r; j++) {
+        if (SORT_CMP(1, arr[j] < pivot_value)) {
+            swap(&arr[i], &arr[j]);
+            i++;
+        }
+    }
+    swap(&arr[i], &arr[high]);
+    return i;
+}
+
+// Ranges of at most small_size elements are finished by the sorting-network kernel
+static void quick_sort_recursive(int *arr, int low, int high, unsigned int *seed,
+                                 PartitionFn partition_fn, int small_size) {
+    while (high - low + 1 > small_size) {
+        int pivot = partition_fn(arr, low, high, seed);
         if (pivot - low < high - pivot) {
-            quick_sort_recursive(arr, low, pivot - 1);
+            quick_sort_recursive(arr, low, pivot - 1, seed, partition_fn, small_size);
             low = pivot + 1;
         } else {
-            quick_sort_recursive(arr, pivot + 1, high);
+            quick_sort_recursive(arr, pivot + 1, high, seed, partition_fn, small_size);
             high = pivot - 1;
         }
     }
+    small_sort(arr + low, high - low + 1);
+}
+
+void quick_sort_with_partition(int *arr, int n, QuickPartitionScheme scheme) {
+    if (arr == NULL || n <= 1) {
+        return;
+    }
+    PartitionFn partition_fn = scheme == QUICK_PARTITION_BLOCK ? partition_block : partition;
+    unsigned int seed = (unsigned int)rand() | 1u;
+    quick_sort_recursive(arr, 0, n - 1, &seed, partition_fn, sort_tuning_get(TUNE_QUICK_SMALL_SORT));
 }
 
 void quick_sort(int *arr, int n) {
+    quick_sort_with_partition(arr, n, QUICK_PARTITION_LOMUTO);
+}
+
+/* ========== Parallel (work-stealing) Quick Sort ========== */
+
+// Shared by every task of one sort; tunables are read once when it starts
+typedef struct {
+    int *arr;
+    int grain;          // Ranges this small are sorted serially by their task
+    int small_size;
+} ParallelQuickContext;
+
+static void parallel_quick_task(ThreadPool *pool, void *arg, int low, int high) {
+    ParallelQuickContext *ctx = (ParallelQuickContext *)arg;
+    int *arr = ctx->arr;
+    unsigned int seed = ((unsigned int)low * 2654435761u) ^ (unsigned int)high ^ 0x9e3779b9u;
+    seed |= 1u;
+
+    // Publish the larger side for thieves and keep partitioning the smaller one
+    while (high - low + 1 > ctx->grain) {
+        int pivot = partition(arr, low, high, &seed);
+        if (pivot - low < high - pivot) {
+            thread_pool_submit(pool, parallel_quick_task, ctx, pivot + 1, high);
+            high = pivot - 1;
+        } else {
+            thread_pool_submit(pool, parallel_quick_task, ctx, low, pivot - 1);
+            low = pivot + 1;
+        }
+    }
+    quick_sort_recursive(arr, low, high, &seed, partition, ctx->small_size);
+}
+
+void parallel_quick_sort(int *arr, int n, int threads) {
     if (arr == NULL || n <= 1) {
         return;
     }
-    quick_sort_recursive(arr, 0, n - 1);
+    // Below the cutoff the pool costs more than it saves
+    if (threads <= 1 || n <= sort_tuning_get(TUNE_PARALLEL_QUICK_CUTOFF)) {
+        quick_sort(arr, n);
+        return;
+    }
+
+    ThreadPool *pool = thread_pool_create(threads);
+    if (pool == NULL) {
+        quick_sort(arr, n);
+        return;
+    }
+
+    ParallelQuickContext ctx = {arr, sort_tuning_get(TUNE_PARALLEL_QUICK_GRAIN),
+                                sort_tuning_get(TUNE_QUICK_SMALL_SORT)};
+    thread_pool_submit(pool, parallel_quick_task, &ctx, 0, n - 1);
+    thread_pool_wait(pool);
+    thread_pool_destroy(pool);
 }
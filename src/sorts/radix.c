@@ -1,61 +1,369 @@
 #include <stdlib.h>
+#include <string.h>
 #include "../../include/sorts.h"
+#include "../../include/sort_alloc.h"
+#include "../../include/sort_instrument.h"
+#include "../../include/sort_tuning.h"
+#include "../../include/thread_pool.h"
 
-static int get_max(int *arr, int n) {
-    int max_val = arr[0];
-    for (int i = 1; i < n; i++) {
-        if (arr[i] > max_val) {
-            max_val = arr[i];
+#define RADIX_MAX_PASSES 4
+
+typedef struct {
+    const int *src;
+    int *dst;
+    int n;
+    int chunks;
+    int bits;
+    int passes;
+    int pass;                   // Current pass for the scatter/histogram tasks
+    unsigned int *hist;         // chunks x passes x radix counters
+    unsigned int *offsets;      // chunks x radix scatter cursors
+} RadixContext;
+
+// Flipping the sign bit maps signed order onto unsigned order
+static inline unsigned int radix_key(int value) {
+    return (unsigned int)value ^ 0x80000000u;
+}
+
+static inline int chunk_begin(const RadixContext *ctx, int chunk) {
+    return (int)((long long)ctx->n * chunk / ctx->chunks);
+}
+
+static unsigned int *chunk_hist(const RadixContext *ctx, int chunk, int pass) {
+    size_t radix = (size_t)1 << ctx->bits;
+    return ctx->hist + ((size_t)chunk * ctx->passes + pass) * radix;
+}
+
+// One read of the input fills the histograms of every pass for this chunk
+static void histogram_all_passes_task(ThreadPool *pool, void *arg, int chunk, int unused) {
+    (void)pool;
+    (void)unused;
+    RadixContext *ctx = (RadixContext *)arg;
+    unsigned int mask = (1u << ctx->bits) - 1;
+    int begin = chunk_begin(ctx, chunk);
+    int end = chunk_begin(ctx, chunk + 1);
+
+    unsigned int *hist[RADIX_MAX_PASSES];
+    for (int p = 0; p < ctx->passes; p++) {
+        hist[p] = chunk_hist(ctx, chunk, p);
+        memset(hist[p], 0, ((size_t)1 << ctx->bits) * sizeof(unsigned int));
+    }
+
+    for (int i = begin; i < end; i++) {
+        unsigned int key = radix_key(ctx->src[i]);
+        for (int p = 0; p < ctx->passes; p++) {
+            hist[p][(key >> (p * ctx->bits)) & mask]++;
         }
     }
-    return max_val;
+    SORT_READS(end - begin);
 }
 
-static void counting_sort_by_digit(int *arr, int n, int exp) {
-    int output_size = n;
-    int *output = (int *)malloc(output_size * sizeof(int));
-    int count[10] = {0};
+// After the first scatter the chunks hold different keys, so recount this pass only
+static void histogram_pass_task(ThreadPool *pool, void *arg, int chunk, int unused) {
+    (void)pool;
+    (void)unused;
+    RadixContext *ctx = (RadixContext *)arg;
+    unsigned int mask = (1u << ctx->bits) - 1;
+    int shift = ctx->pass * ctx->bits;
+    int begin = chunk_begin(ctx, chunk);
+    int end = chunk_begin(ctx, chunk + 1);
 
-    if (output == NULL) {
-        return;
+    unsigned int *hist = chunk_hist(ctx, chunk, ctx->pass);
+    memset(hist, 0, ((size_t)1 << ctx->bits) * sizeof(unsigned int));
+    for (int i = begin; i < end; i++) {
+        hist[(radix_key(ctx->src[i]) >> shift) & mask]++;
     }
+    SORT_READS(end - begin);
+}
 
-    for (int i = 0; i < n; i++) {
-        int digit = (arr[i] / exp) % 10;
-        count[digit]++;
+static void scatter_task(ThreadPool *pool, void *arg, int chunk, int unused) {
+    (void)pool;
+    (void)unused;
+    RadixContext *ctx = (RadixContext *)arg;
+    unsigned int mask = (1u << ctx->bits) - 1;
+    int shift = ctx->pass * ctx->bits;
+    int begin = chunk_begin(ctx, chunk);
+    int end = chunk_begin(ctx, chunk + 1);
+    unsigned int *offsets = ctx->offsets + ((size_t)chunk << ctx->bits);
+    const int *src = ctx->src;
+    int *dst = ctx->dst;
+
+    for (int i = begin; i < end; i++) {
+        int value = src[i];
+        dst[offsets[(radix_key(value) >> shift) & mask]++] = value;
     }
+    SORT_MOVES(end - begin);
+}
 
-    for (int i = 1; i < 10; i++) {
-        count[i] += count[i - 1];
+static void run_chunks(ThreadPool *pool, RadixContext *ctx, ThreadPoolTaskFn fn) {
+    if (pool == NULL) {
+        for (int c = 0; c < ctx->chunks; c++) {
+            fn(NULL, ctx, c, c);
+        }
+    } else {
+        thread_pool_parallel_for(pool, ctx->chunks, fn, ctx);
     }
+}
 
-    for (int i = n - 1; i >= 0; i--) {
-        int digit = (arr[i] / exp) % 10;
-        output[count[digit] - 1] = arr[i];
-        count[digit]--;
+// A pass is a no-op when every key carries the same digit
+static int pass_is_trivial(const RadixContext *ctx, int pass) {
+    size_t radix = (size_t)1 << ctx->bits;
+    for (size_t d = 0; d < radix; d++) {
+        unsigned int total = 0;
+        for (int c = 0; c < ctx->chunks; c++) {
+            total += chunk_hist(ctx, c, pass)[d];
+        }
+        if (total == (unsigned int)ctx->n) {
+            return 1;
+        }
+        if (total != 0) {
+            return 0;
+        }
     }
+    return 0;
+}
 
-    for (int i = 0; i < n; i++) {
-        arr[i] = output[i];
+// Exclusive prefix over (digit, chunk) so each chunk scatters into its own slots
+static void compute_offsets(RadixContext *ctx, int pass) {
+    size_t radix = (size_t)1 << ctx->bits;
+    unsigned int running = 0;
+    for (size_t d = 0; d < radix; d++) {
+        for (int c = 0; c < ctx->chunks; c++) {
+            ctx->offsets[((size_t)c << ctx->bits) + d] = running;
+            running += chunk_hist(ctx, c, pass)[d];
+        }
     }
+}
+
+void radix_sort_bits(int *arr, int n, int digit_bits, int threads) {
+    if (arr == NULL || n <= 1) {
+        return;
+    }
+    if (digit_bits != 8 && digit_bits != 11 && digit_bits != 16) {
+        digit_bits = 8;
+    }
+    // Below the cutoff the per-thread histograms cost more than they save
+    if (threads < 1 || n < sort_tuning_get(TUNE_PARALLEL_RADIX_CUTOFF)) {
+        threads = 1;
+    }
+
+    RadixContext ctx;
+    ctx.n = n;
+    ctx.chunks = threads;
+    ctx.bits = digit_bits;
+    ctx.passes = (32 + digit_bits - 1) / digit_bits;
+
+    size_t radix = (size_t)1 << digit_bits;
+    int *buffer = (int *)sort_malloc((size_t)n * sizeof(int));
+    ctx.hist = (unsigned int *)sort_malloc((size_t)threads * ctx.passes * radix * sizeof(unsigned int));
+    ctx.offsets = (unsigned int *)sort_malloc((size_t)threads * radix * sizeof(unsigned int));
+    ThreadPool *pool = threads > 1 ? thread_pool_create(threads) : NULL;
+
+    if (buffer == NULL || ctx.hist == NULL || ctx.offsets == NULL || (threads > 1 && pool == NULL)) {
+        sort_free(buffer);
+        sort_free(ctx.hist);
+        sort_free(ctx.offsets);
+        thread_pool_destroy(pool);
+        return;
+    }
+
+    ctx.src = arr;
+    ctx.dst = buffer;
+    run_chunks(pool, &ctx, histogram_all_passes_task);
+
+    // Chunk histograms from the up-front count stay valid until the first scatter
+    int scattered = 0;
+    for (int pass = 0; pass < ctx.passes; pass++) {
+        if (pass_is_trivial(&ctx, pass)) {
+            continue;
+        }
+
+        ctx.pass = pass;
+        if (scattered && threads > 1) {
+            run_chunks(pool, &ctx, histogram_pass_task);
+        }
+        compute_offsets(&ctx, pass);
+        run_chunks(pool, &ctx, scatter_task);
+
+        // Ping-pong: this pass's output is the next pass's input
+        int *next_src = ctx.dst;
+        ctx.dst = (int *)ctx.src;
+        ctx.src = next_src;
+        scattered = 1;
+    }
+
+    if (ctx.src != arr) {
+        memcpy(arr, ctx.src, (size_t)n * sizeof(int));
+        SORT_MOVES(n);
+    }
+
+    thread_pool_destroy(pool);
+    sort_free(buffer);
+    sort_free(ctx.hist);
+    sort_free(ctx.offsets);
+}
 
-    free(output);
+// Wider digits mean fewer passes but larger histograms; they only pay off from some size up
+static int tuned_digit_bits(int n) {
+    return n >= sort_tuning_get(TUNE_RADIX_WIDE_CUTOFF) ? sort_tuning_get(TUNE_RADIX_DIGIT_BITS) : 8;
 }
 
 void radix_sort(int *arr, int n) {
+    radix_sort_bits(arr, n, tuned_digit_bits(n), 1);
+}
+
+void parallel_radix_sort(int *arr, int n, int threads) {
+    radix_sort_bits(arr, n, tuned_digit_bits(n), threads);
+}
+
+/* ========== Typed keys: 64-bit integers and IEEE floats ========== */
+
+#define TYPED_RADIX_BITS 8
+#define TYPED_RADIX_SIZE (1 << TYPED_RADIX_BITS)
+
+/*
+ * Each typed entry point maps its values onto unsigned keys whose unsigned
+ * order is the value order, sorts those, and maps them back:
+ *   int64:  flip the sign bit
+ *   float:  flip the sign bit of non-negatives, every bit of negatives
+ *           (-NaN < -inf < ... < -0 < +0 < ... < +inf < +NaN)
+ */
+#define DEFINE_TYPED_RADIX_ENGINE(ukey_t, passes)                                   \
+    static void radix_sort_keys_##ukey_t(ukey_t *keys, ukey_t *buffer, int n) {     \
+        unsigned int hist[passes][TYPED_RADIX_SIZE];                                \
+        memset(hist, 0, sizeof(hist));                                              \
+        for (int i = 0; i < n; i++) {                                               \
+            for (int p = 0; p < (passes); p++) {                                    \
+                hist[p][(keys[i] >> (p * TYPED_RADIX_BITS)) & (TYPED_RADIX_SIZE - 1)]++; \
+            }                                                                       \
+        }                                                                           \
+                                                                                    \
+        ukey_t *src = keys;                                                         \
+        ukey_t *dst = buffer;                                                       \
+        for (int p = 0; p < (passes); p++) {                                        \
+            unsigned int running = 0;                                               \
+            int trivial = 0;                                                        \
+            for (int d = 0; d < TYPED_RADIX_SIZE; d++) {                            \
+                unsigned int count = hist[p][d];                                    \
+                trivial |= count == (unsigned int)n;                                \
+                hist[p][d] = running;                                               \
+                running += count;                                                   \
+            }                                                                       \
+            if (trivial) {                                                          \
+                continue;                                                           \
+            }                                                                       \
+            for (int i = 0; i < n; i++) {                                           \
+                ukey_t key = src[i];                                                \
+                dst[hist[p][(key >> (p * TYPED_RADIX_BITS)) & (TYPED_RADIX_SIZE - 1)]++] = key; \
+            }                                                                       \
+            ukey_t *next_src = dst;                                                 \
+            dst = src;                                                              \
+            src = next_src;                                                         \
+        }                                                                           \
+                                                                                    \
+        if (src != keys) {                                                          \
+            memcpy(keys, src, (size_t)n * sizeof(ukey_t));                          \
+        }                                                                           \
+    }
+
+DEFINE_TYPED_RADIX_ENGINE(uint32_t, 4)
+DEFINE_TYPED_RADIX_ENGINE(uint64_t, 8)
+
+static inline uint32_t float_key(uint32_t bits) {
+    return bits ^ ((uint32_t)((int32_t)bits >> 31) | 0x80000000u);
+}
+
+static inline uint32_t float_unkey(uint32_t key) {
+    return key ^ (((key >> 31) - 1) | 0x80000000u);
+}
+
+static inline uint64_t double_key(uint64_t bits) {
+    return bits ^ ((uint64_t)((int64_t)bits >> 63) | 0x8000000000000000ull);
+}
+
+static inline uint64_t double_unkey(uint64_t key) {
+    return key ^ (((key >> 63) - 1) | 0x8000000000000000ull);
+}
+
+void radix_sort_u64(uint64_t *arr, int n) {
     if (arr == NULL || n <= 1) {
         return;
     }
+    uint64_t *buffer = (uint64_t *)sort_malloc((size_t)n * sizeof(uint64_t));
+    if (buffer == NULL) {
+        return;
+    }
+    radix_sort_keys_uint64_t(arr, buffer, n);
+    sort_free(buffer);
+}
 
+void radix_sort_i64(int64_t *arr, int n) {
+    if (arr == NULL || n <= 1) {
+        return;
+    }
+    uint64_t *buffer = (uint64_t *)sort_malloc((size_t)n * sizeof(uint64_t));
+    if (buffer == NULL) {
+        return;
+    }
+    // Signed and unsigned views of the same array may alias, so flip in place
+    uint64_t *keys = (uint64_t *)arr;
     for (int i = 0; i < n; i++) {
-        if (arr[i] < 0) {
-            return;
-        }
+        keys[i] ^= 0x8000000000000000ull;
+    }
+    radix_sort_keys_uint64_t(keys, buffer, n);
+    for (int i = 0; i < n; i++) {
+        keys[i] ^= 0x8000000000000000ull;
     }
+    sort_free(buffer);
+}
 
-    int max_val = get_max(arr, n);
+// Floats cannot alias their bit patterns, so keys live in a staging array
+void radix_sort_f32(float *arr, int n) {
+    if (arr == NULL || n <= 1) {
+        return;
+    }
+    uint32_t *keys = (uint32_t *)sort_malloc((size_t)n * sizeof(uint32_t));
+    uint32_t *buffer = (uint32_t *)sort_malloc((size_t)n * sizeof(uint32_t));
+    if (keys == NULL || buffer == NULL) {
+        sort_free(keys);
+        sort_free(buffer);
+        return;
+    }
+    for (int i = 0; i < n; i++) {
+        uint32_t bits;
+        memcpy(&bits, &arr[i], sizeof(bits));
+        keys[i] = float_key(bits);
+    }
+    radix_sort_keys_uint32_t(keys, buffer, n);
+    for (int i = 0; i < n; i++) {
+        uint32_t bits = float_unkey(keys[i]);
+        memcpy(&arr[i], &bits, sizeof(bits));
+    }
+    sort_free(keys);
+    sort_free(buffer);
+}
 
-    for (int exp = 1; max_val / exp > 0; exp *= 10) {
-        counting_sort_by_digit(arr, n, exp);
+void radix_sort_f64(double *arr, int n) {
+    if (arr == NULL || n <= 1) {
+        return;
+    }
+    uint64_t *keys = (uint64_t *)sort_malloc((size_t)n * sizeof(uint64_t));
+    uint64_t *buffer = (uint64_t *)sort_malloc((size_t)n * sizeof(uint64_t));
+    if (keys == NULL || buffer == NULL) {
+        sort_free(keys);
+        sort_free(buffer);
+        return;
+    }
+    for (int i = 0; i < n; i++) {
+        uint64_t bits;
+        memcpy(&bits, &arr[i], sizeof(bits));
+        keys[i] = double_key(bits);
+    }
+    radix_sort_keys_uint64_t(keys, buffer, n);
+    for (int i = 0; i < n; i++) {
+        uint64_t bits = double_unkey(keys[i]);
+        memcpy(&arr[i], &bits, sizeof(bits));
     }
+    sort_free(keys);
+    sort_free(buffer);
 }
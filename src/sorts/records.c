@@ -0,0 +1,375 @@
+#include <stdlib.h>
+#include <string.h>
+#include "../../include/record_sorts.h"
+#include "../../include/sort_alloc.h"
+
+#define RECORD_RADIX_BITS 8
+#define RECORD_RADIX_SIZE (1 << RECORD_RADIX_BITS)
+// Leaf runs of the bottom-up merge are insertion-sorted (stable)
+#define RECORD_RUN_SIZE 32
+// Quick sort hands slices this small to insertion sort
+#define RECORD_INSERTION_THRESHOLD 24
+
+// xorshift32 pivot generator, as in quick.c
+static unsigned int next_random(unsigned int *state) {
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+/*
+ * The array-of-structs engines only differ in the record type, so they are
+ * stamped out per layout. `radix_key` maps signed key order onto unsigned
+ * order by flipping the sign bit; `passes` is the key width in bytes.
+ */
+#define DEFINE_RECORD_SORTS(prefix, Record, ukey_t, sign_bit, passes)               \
+    static inline ukey_t prefix##_radix_key(const Record *r) {                      \
+        return (ukey_t)r->key ^ (sign_bit);                                         \
+    }                                                                               \
+                                                                                    \
+    void prefix##_radix_sort(Record *records, int n) {                              \
+        if (records == NULL || n <= 1) {                                            \
+            return;                                                                 \
+        }                                                                           \
+        Record *buffer = (Record *)sort_malloc((size_t)n * sizeof(Record));         \
+        if (buffer == NULL) {                                                       \
+            return;                                                                 \
+        }                                                                           \
+                                                                                    \
+        /* One read of the input fills the histograms of every pass */              \
+        unsigned int hist[passes][RECORD_RADIX_SIZE];                               \
+        memset(hist, 0, sizeof(hist));                                              \
+        for (int i = 0; i < n; i++) {                                               \
+            ukey_t key = prefix##_radix_key(&records[i]);                           \
+            for (int p = 0; p < (passes); p++) {                                    \
+                hist[p][(key >> (p * RECORD_RADIX_BITS)) & (RECORD_RADIX_SIZE - 1)]++; \
+            }                                                                       \
+        }                                                                           \
+                                                                                    \
+        Record *src = records;                                                      \
+        Record *dst = buffer;                                                       \
+        for (int p = 0; p < (passes); p++) {                                        \
+            unsigned int running = 0;                                               \
+            int trivial = 0;                                                        \
+            for (int d = 0; d < RECORD_RADIX_SIZE; d++) {                           \
+                unsigned int count = hist[p][d];                                    \
+                trivial |= count == (unsigned int)n;                                \
+                hist[p][d] = running;                                               \
+                running += count;                                                   \
+            }                                                                       \
+            if (trivial) {                                                          \
+                continue; /* Every key carries the same digit */                    \
+            }                                                                       \
+            for (int i = 0; i < n; i++) {                                           \
+                ukey_t key = prefix##_radix_key(&src[i]);                           \
+                dst[hist[p][(key >> (p * RECORD_RADIX_BITS)) & (RECORD_RADIX_SIZE - 1)]++] = src[i]; \
+            }                                                                       \
+            Record *next_src = dst;                                                 \
+            dst = src;                                                              \
+            src = next_src;                                                         \
+        }                                                                           \
+                                                                                    \
+        if (src != records) {                                                       \
+            memcpy(records, src, (size_t)n * sizeof(Record));                       \
+        }                                                                           \
+        sort_free(buffer);                                                          \
+    }                                                                               \
+                                                                                    \
+    static void prefix##_insertion_sort(Record *records, int n) {                   \
+        for (int i = 1; i < n; i++) {                                               \
+            Record current = records[i];                                            \
+            int j = i;                                                              \
+            while (j > 0 && records[j - 1].key > current.key) {                     \
+                records[j] = records[j - 1];                                        \
+                j--;                                                                \
+            }                                                                       \
+            records[j] = current;                                                   \
+        }                                                                           \
+    }                                                                               \
+                                                                                    \
+    void prefix##_merge_sort(Record *records, int n) {                              \
+        if (records == NULL || n <= 1) {                                            \
+            return;                                                                 \
+        }                                                                           \
+        for (int lo = 0; lo < n; lo += RECORD_RUN_SIZE) {                           \
+            int len = n - lo < RECORD_RUN_SIZE ? n - lo : RECORD_RUN_SIZE;          \
+            prefix##_insertion_sort(records + lo, len);                             \
+        }                                                                           \
+        if (n <= RECORD_RUN_SIZE) {                                                 \
+            return;                                                                 \
+        }                                                                           \
+        Record *buffer = (Record *)sort_malloc((size_t)n * sizeof(Record));         \
+        if (buffer == NULL) {                                                       \
+            return;                                                                 \
+        }                                                                           \
+                                                                                    \
+        Record *src = records;                                                      \
+        Record *dst = buffer;                                                       \
+        for (int width = RECORD_RUN_SIZE; width < n; width *= 2) {                  \
+            for (int lo = 0; lo < n; lo += 2 * width) {                             \
+                int mid = lo + width < n ? lo + width : n;                          \
+                int hi = lo + 2 * width < n ? lo + 2 * width : n;                   \
+                int i = lo, j = mid, k = lo;                                        \
+                while (i < mid && j < hi) {                                         \
+                    dst[k++] = src[j].key < src[i].key ? src[j++] : src[i++];       \
+                }                                                                   \
+                while (i < mid) {                                                   \
+                    dst[k++] = src[i++];                                            \
+                }                                                                   \
+                while (j < hi) {                                                    \
+                    dst[k++] = src[j++];                                            \
+                }                                                                   \
+            }                                                                       \
+            Record *next_src = dst;                                                 \
+            dst = src;                                                              \
+            src = next_src;                                                         \
+        }                                                                           \
+                                                                                    \
+        if (src != records) {                                                       \
+            memcpy(records, src, (size_t)n * sizeof(Record));                       \
+        }                                                                           \
+        sort_free(buffer);                                                          \
+    }                                                                               \
+                                                                                    \
+    /* Hoare partition around a random key moved to records[low] */                 \
+    static int prefix##_partition(Record *records, int low, int high,               \
+                                  unsigned int *seed) {                             \
+        int pick = low + (int)(next_random(seed) % (unsigned int)(high - low + 1)); \
+        Record temp = records[low];                                                 \
+        records[low] = records[pick];                                               \
+        records[pick] = temp;                                                       \
+        Record pivot = records[low];                                                \
+        int i = low - 1;                                                            \
+        int j = high + 1;                                                           \
+        for (;;) {                                                                  \
+            do {                                                                    \
+                i++;                                                                \
+            } while (records[i].key < pivot.key);                                   \
+            do {                                                                    \
+                j--;                                                                \
+            } while (records[j].key > pivot.key);                                   \
+            if (i >= j) {                                                           \
+                return j;                                                           \
+            }                                                                       \
+            temp = records[i];                                                      \
+            records[i] = records[j];                                                \
+            records[j] = temp;                                                      \
+        }                                                                           \
+    }                                                                               \
+                                                                                    \
+    static void prefix##_quick_recursive(Record *records, int low, int high,        \
+                                         unsigned int *seed) {                      \
+        while (high - low + 1 > RECORD_INSERTION_THRESHOLD) {                       \
+            int split = prefix##_partition(records, low, high, seed);               \
+            if (split - low < high - split) {                                       \
+                prefix##_quick_recursive(records, low, split, seed);                \
+                low = split + 1;                                                    \
+            } else {                                                                \
+                prefix##_quick_recursive(records, split + 1, high, seed);           \
+                high = split;                                                       \
+            }                                                                       \
+        }                                                                           \
+        prefix##_insertion_sort(records + low, high - low + 1);                     \
+    }                                                                               \
+                                                                                    \
+    void prefix##_quick_sort(Record *records, int n) {                              \
+        if (records == NULL || n <= 1) {                                            \
+            return;                                                                 \
+        }                                                                           \
+        unsigned int seed = (unsigned int)rand() | 1u;                              \
+        prefix##_quick_recursive(records, 0, n - 1, &seed);                         \
+    }
+
+DEFINE_RECORD_SORTS(record32, Record32, uint32_t, 0x80000000u, 4)
+DEFINE_RECORD_SORTS(record64, Record64, uint64_t, 0x8000000000000000ull, 8)
+
+/* ========== Struct of arrays: key and value columns ========== */
+
+static inline uint32_t soa_radix_key(int32_t key) {
+    return (uint32_t)key ^ 0x80000000u;
+}
+
+void record_soa_radix_sort(int32_t *keys, uint32_t *values, int n) {
+    if (keys == NULL || values == NULL || n <= 1) {
+        return;
+    }
+    int32_t *key_buffer = (int32_t *)sort_malloc((size_t)n * sizeof(int32_t));
+    uint32_t *value_buffer = (uint32_t *)sort_malloc((size_t)n * sizeof(uint32_t));
+    if (key_buffer == NULL || value_buffer == NULL) {
+        sort_free(key_buffer);
+        sort_free(value_buffer);
+        return;
+    }
+
+    // Only the key column is read to build the histograms
+    unsigned int hist[4][RECORD_RADIX_SIZE];
+    memset(hist, 0, sizeof(hist));
+    for (int i = 0; i < n; i++) {
+        uint32_t key = soa_radix_key(keys[i]);
+        for (int p = 0; p < 4; p++) {
+            hist[p][(key >> (p * RECORD_RADIX_BITS)) & (RECORD_RADIX_SIZE - 1)]++;
+        }
+    }
+
+    int32_t *src_keys = keys, *dst_keys = key_buffer;
+    uint32_t *src_values = values, *dst_values = value_buffer;
+    for (int p = 0; p < 4; p++) {
+        unsigned int running = 0;
+        int trivial = 0;
+        for (int d = 0; d < RECORD_RADIX_SIZE; d++) {
+            unsigned int count = hist[p][d];
+            trivial |= count == (unsigned int)n;
+            hist[p][d] = running;
+            running += count;
+        }
+        if (trivial) {
+            continue;
+        }
+        for (int i = 0; i < n; i++) {
+            unsigned int pos = hist[p][(soa_radix_key(src_keys[i]) >> (p * RECORD_RADIX_BITS)) &
+                                       (RECORD_RADIX_SIZE - 1)]++;
+            dst_keys[pos] = src_keys[i];
+            dst_values[pos] = src_values[i];
+        }
+        int32_t *next_keys = dst_keys;
+        dst_keys = src_keys;
+        src_keys = next_keys;
+        uint32_t *next_values = dst_values;
+        dst_values = src_values;
+        src_values = next_values;
+    }
+
+    if (src_keys != keys) {
+        memcpy(keys, src_keys, (size_t)n * sizeof(int32_t));
+        memcpy(values, src_values, (size_t)n * sizeof(uint32_t));
+    }
+    sort_free(key_buffer);
+    sort_free(value_buffer);
+}
+
+static void soa_insertion_sort(int32_t *keys, uint32_t *values, int n) {
+    for (int i = 1; i < n; i++) {
+        int32_t key = keys[i];
+        uint32_t value = values[i];
+        int j = i;
+        while (j > 0 && keys[j - 1] > key) {
+            keys[j] = keys[j - 1];
+            values[j] = values[j - 1];
+            j--;
+        }
+        keys[j] = key;
+        values[j] = value;
+    }
+}
+
+void record_soa_merge_sort(int32_t *keys, uint32_t *values, int n) {
+    if (keys == NULL || values == NULL || n <= 1) {
+        return;
+    }
+    for (int lo = 0; lo < n; lo += RECORD_RUN_SIZE) {
+        int len = n - lo < RECORD_RUN_SIZE ? n - lo : RECORD_RUN_SIZE;
+        soa_insertion_sort(keys + lo, values + lo, len);
+    }
+    if (n <= RECORD_RUN_SIZE) {
+        return;
+    }
+    int32_t *key_buffer = (int32_t *)sort_malloc((size_t)n * sizeof(int32_t));
+    uint32_t *value_buffer = (uint32_t *)sort_malloc((size_t)n * sizeof(uint32_t));
+    if (key_buffer == NULL || value_buffer == NULL) {
+        sort_free(key_buffer);
+        sort_free(value_buffer);
+        return;
+    }
+
+    int32_t *src_keys = keys, *dst_keys = key_buffer;
+    uint32_t *src_values = values, *dst_values = value_buffer;
+    for (int width = RECORD_RUN_SIZE; width < n; width *= 2) {
+        for (int lo = 0; lo < n; lo += 2 * width) {
+            int mid = lo + width < n ? lo + width : n;
+            int hi = lo + 2 * width < n ? lo + 2 * width : n;
+            int i = lo, j = mid, k = lo;
+            while (i < mid && j < hi) {
+                // Ties take the left run, which keeps the merge stable
+                int from = src_keys[j] < src_keys[i] ? j++ : i++;
+                dst_keys[k] = src_keys[from];
+                dst_values[k++] = src_values[from];
+            }
+            for (; i < mid; i++, k++) {
+                dst_keys[k] = src_keys[i];
+                dst_values[k] = src_values[i];
+            }
+            for (; j < hi; j++, k++) {
+                dst_keys[k] = src_keys[j];
+                dst_values[k] = src_values[j];
+            }
+        }
+        int32_t *next_keys = dst_keys;
+        dst_keys = src_keys;
+        src_keys = next_keys;
+        uint32_t *next_values = dst_values;
+        dst_values = src_values;
+        src_values = next_values;
+    }
+
+    if (src_keys != keys) {
+        memcpy(keys, src_keys, (size_t)n * sizeof(int32_t));
+        memcpy(values, src_values, (size_t)n * sizeof(uint32_t));
+    }
+    sort_free(key_buffer);
+    sort_free(value_buffer);
+}
+
+static inline void soa_swap(int32_t *keys, uint32_t *values, int a, int b) {
+    int32_t key = keys[a];
+    keys[a] = keys[b];
+    keys[b] = key;
+    uint32_t value = values[a];
+    values[a] = values[b];
+    values[b] = value;
+}
+
+static int soa_partition(int32_t *keys, uint32_t *values, int low, int high, unsigned int *seed) {
+    int pick = low + (int)(next_random(seed) % (unsigned int)(high - low + 1));
+    soa_swap(keys, values, low, pick);
+    int32_t pivot = keys[low];
+    int i = low - 1;
+    int j = high + 1;
+    for (;;) {
+        do {
+            i++;
+        } while (keys[i] < pivot);
+        do {
+            j--;
+        } while (keys[j] > pivot);
+        if (i >= j) {
+            return j;
+        }
+        soa_swap(keys, values, i, j);
+    }
+}
+
+static void soa_quick_recursive(int32_t *keys, uint32_t *values, int low, int high,
+                                unsigned int *seed) {
+    while (high - low + 1 > RECORD_INSERTION_THRESHOLD) {
+        int split = soa_partition(keys, values, low, high, seed);
+        if (split - low < high - split) {
+            soa_quick_recursive(keys, values, low, split, seed);
+            low = split + 1;
+        } else {
+            soa_quick_recursive(keys, values, split + 1, high, seed);
+            high = split;
+        }
+    }
+    soa_insertion_sort(keys + low, values + low, high - low + 1);
+}
+
+void record_soa_quick_sort(int32_t *keys, uint32_t *values, int n) {
+    if (keys == NULL || values == NULL || n <= 1) {
+        return;
+    }
+    unsigned int seed = (unsigned int)rand() | 1u;
+    soa_quick_recursive(keys, values, 0, n - 1, &seed);
+}
@@ -0,0 +1,285 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../include/sorts.h"
+#include "../../include/sort_alloc.h"
+#include "../../include/sort_tuning.h"
+#include "../../include/thread_pool.h"
+
+// Bucket ids are stored in one byte per element
+#define SAMPLE_MAX_BUCKETS 256
+// Buckets per thread, so work stealing can even out skewed buckets
+#define SAMPLE_BUCKETS_PER_THREAD 8
+// Sample keys drawn per bucket when picking splitters
+#define SAMPLE_OVERSAMPLING 16
+// Elements classified side by side to keep several tree walks in flight
+#define SAMPLE_UNROLL 4
+
+typedef struct {
+    int *arr;
+    int *buffer;
+    uint8_t *oracle;            // Bucket id of every element, filled by classify
+    int n;
+    int chunks;
+    int buckets;                // Leaves of the splitter tree, a power of two
+    int log_buckets;
+    bool equality_buckets;      // Keys equal to splitter b get their own bucket 2b + 1
+    int classes;                // Bucket ids: buckets, doubled with equality buckets
+    int tree[SAMPLE_MAX_BUCKETS];  // Implicit search tree over the splitters, root at 1
+    int splitters[SAMPLE_MAX_BUCKETS];  // Sorted splitters, last one repeated past the end
+    unsigned int *hist;         // chunks x classes counts, turned into scatter cursors
+    unsigned int *bucket_start; // classes + 1 entries
+    unsigned int *group_total;  // Prefix-sum partial per bucket group (one per chunk)
+} SampleContext;
+
+static inline int chunk_begin(const SampleContext *ctx, int chunk) {
+    return (int)((long long)ctx->n * chunk / ctx->chunks);
+}
+
+static inline int group_begin(const SampleContext *ctx, int group) {
+    return ctx->classes * group / ctx->chunks;
+}
+
+static unsigned int next_random(unsigned int *state) {
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+// Every step-th key of the sorted sample, repeats dropped; returns the splitter count
+static int pick_splitters(const int *sample, int step, int buckets, int *splitters) {
+    int unique = 0;
+    for (int i = 1; i < buckets; i++) {
+        int value = sample[i * step - 1];
+        if (unique == 0 || value != splitters[unique - 1]) {
+            splitters[unique++] = value;
+        }
+    }
+    return unique;
+}
+
+/*
+ * Pick buckets - 1 splitters from a sorted random sample and lay them out as
+ * an implicit binary search tree (children of node i at 2i and 2i + 1).
+ *
+ * A repeated splitter means a key fills more than a bucket's share of the
+ * input. Its copies would all land in one bucket and leave a single task to
+ * sort them, so each splitter then gets an equality bucket of its own, which
+ * needs no sorting. The tree is halved if the doubled ids would not fit.
+ * Returns false if the sample cannot be allocated.
+ */
+static bool build_splitter_tree(SampleContext *ctx) {
+    int sample_size = ctx->buckets * SAMPLE_OVERSAMPLING;
+    int *sample = (int *)sort_malloc((size_t)sample_size * sizeof(int));
+    if (sample == NULL) {
+        return false;
+    }
+
+    unsigned int seed = 0x9e3779b9u ^ (unsigned int)ctx->n;
+    for (int i = 0; i < sample_size; i++) {
+        sample[i] = ctx->arr[next_random(&seed) % (unsigned int)ctx->n];
+    }
+    intro_sort(sample, sample_size);
+
+    int *splitters = ctx->splitters;
+    int unique = pick_splitters(sample, SAMPLE_OVERSAMPLING, ctx->buckets, splitters);
+    ctx->equality_buckets = unique < ctx->buckets - 1;
+    if (ctx->equality_buckets && 2 * ctx->buckets > SAMPLE_MAX_BUCKETS) {
+        ctx->buckets /= 2;
+        ctx->log_buckets--;
+        unique = pick_splitters(sample, 2 * SAMPLE_OVERSAMPLING, ctx->buckets, splitters);
+    }
+    ctx->classes = ctx->equality_buckets ? 2 * ctx->buckets : ctx->buckets;
+    sort_free(sample);
+
+    // Padding with the last splitter leaves trailing buckets empty; past the
+    // end it keeps the top bucket's keys (all above it) out of equality bucket
+    for (int i = unique; i < ctx->buckets; i++) {
+        splitters[i] = splitters[unique - 1];
+    }
+
+    // In-order positions of a complete tree map onto the sorted splitters
+    for (int level = 0, first = 1; first < ctx->buckets; level++, first *= 2) {
+        int step = ctx->buckets >> level;
+        for (int node = first; node < 2 * first; node++) {
+            ctx->tree[node] = splitters[(node - first) * step + step / 2 - 1];
+        }
+    }
+    return true;
+}
+
+// Bucket id of a key that left the tree at bucket b: 2b or 2b + 1 with equality buckets
+static inline int bucket_class(const SampleContext *ctx, int bucket, int value) {
+    if (ctx->equality_buckets) {
+        return 2 * bucket + (value == ctx->splitters[bucket]);
+    }
+    return bucket;
+}
+
+// Walk the splitter tree without branches: bucket b holds keys in (s[b-1], s[b]]
+static inline int classify(const SampleContext *ctx, int value) {
+    int node = 1;
+    for (int level = 0; level < ctx->log_buckets; level++) {
+        node = 2 * node + (value > ctx->tree[node]);
+    }
+    return bucket_class(ctx, node - ctx->buckets, value);
+}
+
+static void classify_task(ThreadPool *pool, void *arg, int chunk, int unused) {
+    (void)pool;
+    (void)unused;
+    SampleContext *ctx = (SampleContext *)arg;
+    int begin = chunk_begin(ctx, chunk);
+    int end = chunk_begin(ctx, chunk + 1);
+    unsigned int *hist = ctx->hist + (size_t)chunk * ctx->classes;
+    const int *arr = ctx->arr;
+    memset(hist, 0, (size_t)ctx->classes * sizeof(unsigned int));
+
+    int i = begin;
+    for (; i + SAMPLE_UNROLL <= end; i += SAMPLE_UNROLL) {
+        int node[SAMPLE_UNROLL];
+        for (int u = 0; u < SAMPLE_UNROLL; u++) {
+            node[u] = 1;
+        }
+        for (int level = 0; level < ctx->log_buckets; level++) {
+            for (int u = 0; u < SAMPLE_UNROLL; u++) {
+                node[u] = 2 * node[u] + (arr[i + u] > ctx->tree[node[u]]);
+            }
+        }
+        for (int u = 0; u < SAMPLE_UNROLL; u++) {
+            int bucket = bucket_class(ctx, node[u] - ctx->buckets, arr[i + u]);
+            ctx->oracle[i + u] = (uint8_t)bucket;
+            hist[bucket]++;
+        }
+    }
+    for (; i < end; i++) {
+        int bucket = classify(ctx, arr[i]);
+        ctx->oracle[i] = (uint8_t)bucket;
+        hist[bucket]++;
+    }
+}
+
+// Prefix sum, step 1: total size of the buckets in this group
+static void group_total_task(ThreadPool *pool, void *arg, int group, int unused) {
+    (void)pool;
+    (void)unused;
+    SampleContext *ctx = (SampleContext *)arg;
+    unsigned int total = 0;
+    for (int b = group_begin(ctx, group); b < group_begin(ctx, group + 1); b++) {
+        for (int c = 0; c < ctx->chunks; c++) {
+            total += ctx->hist[(size_t)c * ctx->classes + b];
+        }
+    }
+    ctx->group_total[group] = total;
+}
+
+// Prefix sum, step 2: from the group's start, give every (bucket, chunk) its slot
+static void group_offsets_task(ThreadPool *pool, void *arg, int group, int unused) {
+    (void)pool;
+    (void)unused;
+    SampleContext *ctx = (SampleContext *)arg;
+    unsigned int running = ctx->group_total[group];
+    for (int b = group_begin(ctx, group); b < group_begin(ctx, group + 1); b++) {
+        ctx->bucket_start[b] = running;
+        for (int c = 0; c < ctx->chunks; c++) {
+            unsigned int *cell = ctx->hist + (size_t)c * ctx->classes + b;
+            unsigned int count = *cell;
+            *cell = running;
+            running += count;
+        }
+    }
+}
+
+static void scatter_task(ThreadPool *pool, void *arg, int chunk, int unused) {
+    (void)pool;
+    (void)unused;
+    SampleContext *ctx = (SampleContext *)arg;
+    int begin = chunk_begin(ctx, chunk);
+    int end = chunk_begin(ctx, chunk + 1);
+    unsigned int *cursor = ctx->hist + (size_t)chunk * ctx->classes;
+    for (int i = begin; i < end; i++) {
+        ctx->buffer[cursor[ctx->oracle[i]]++] = ctx->arr[i];
+    }
+}
+
+// Sort one bucket in the scratch buffer and copy it home; equality buckets are already sorted
+static void bucket_sort_task(ThreadPool *pool, void *arg, int bucket, int unused) {
+    (void)pool;
+    (void)unused;
+    SampleContext *ctx = (SampleContext *)arg;
+    unsigned int begin = ctx->bucket_start[bucket];
+    int size = (int)(ctx->bucket_start[bucket + 1] - begin);
+    if (!ctx->equality_buckets || bucket % 2 == 0) {
+        intro_sort(ctx->buffer + begin, size);
+    }
+    memcpy(ctx->arr + begin, ctx->buffer + begin, (size_t)size * sizeof(int));
+}
+
+void parallel_sample_sort(int *arr, int n, int threads) {
+    if (arr == NULL || n <= 1) {
+        return;
+    }
+    // Below the cutoff the serial engine wins outright
+    if (threads <= 1 || n < sort_tuning_get(TUNE_PARALLEL_SAMPLE_CUTOFF)) {
+        intro_sort(arr, n);
+        return;
+    }
+
+    SampleContext ctx;
+    ctx.arr = arr;
+    ctx.n = n;
+    ctx.chunks = threads;
+    ctx.buckets = 2;
+    ctx.log_buckets = 1;
+    while (ctx.buckets < threads * SAMPLE_BUCKETS_PER_THREAD && ctx.buckets < SAMPLE_MAX_BUCKETS) {
+        ctx.buckets *= 2;
+        ctx.log_buckets++;
+    }
+    ctx.buffer = (int *)sort_malloc((size_t)n * sizeof(int));
+    ctx.oracle = (uint8_t *)sort_malloc((size_t)n);
+    // Room for equality buckets, in case the sample asks for them
+    int max_classes = 2 * ctx.buckets < SAMPLE_MAX_BUCKETS ? 2 * ctx.buckets : SAMPLE_MAX_BUCKETS;
+    ctx.hist = (unsigned int *)sort_malloc((size_t)threads * max_classes * sizeof(unsigned int));
+    ctx.bucket_start = (unsigned int *)sort_malloc(((size_t)max_classes + 1) * sizeof(unsigned int));
+    ctx.group_total = (unsigned int *)sort_malloc((size_t)threads * sizeof(unsigned int));
+    ThreadPool *pool = thread_pool_create(threads);
+
+    if (ctx.buffer == NULL || ctx.oracle == NULL || ctx.hist == NULL ||
+        ctx.bucket_start == NULL || ctx.group_total == NULL || pool == NULL ||
+        !build_splitter_tree(&ctx)) {
+        sort_free(ctx.buffer);
+        sort_free(ctx.oracle);
+        sort_free(ctx.hist);
+        sort_free(ctx.bucket_start);
+        sort_free(ctx.group_total);
+        thread_pool_destroy(pool);
+        intro_sort(arr, n);
+        return;
+    }
+
+    thread_pool_parallel_for(pool, ctx.chunks, classify_task, &ctx);
+
+    thread_pool_parallel_for(pool, ctx.chunks, group_total_task, &ctx);
+    unsigned int running = 0;
+    for (int g = 0; g < ctx.chunks; g++) {
+        unsigned int total = ctx.group_total[g];
+        ctx.group_total[g] = running;
+        running += total;
+    }
+    thread_pool_parallel_for(pool, ctx.chunks, group_offsets_task, &ctx);
+    ctx.bucket_start[ctx.classes] = (unsigned int)n;
+
+    thread_pool_parallel_for(pool, ctx.chunks, scatter_task, &ctx);
+    thread_pool_parallel_for(pool, ctx.classes, bucket_sort_task, &ctx);
+
+    thread_pool_destroy(pool);
+    sort_free(ctx.buffer);
+    sort_free(ctx.oracle);
+    sort_free(ctx.hist);
+    sort_free(ctx.bucket_start);
+    sort_free(ctx.group_total);
+}
@@ -1,10 +1,11 @@
 #include "../../include/sorts.h"
+#include "../../include/sort_instrument.h"
 
 void selection_sort(int *arr, int n) {
     for (int i = 0; i < n - 1; i++) {
         int min_idx = i;
         for (int j = i + 1; j < n; j++) {
-            if (arr[j] < arr[min_idx]) {
+            if (SORT_CMP(2, arr[j] < arr[min_idx])) {
                 min_idx = j;
             }
         }
@@ -12,6 +13,7 @@ void selection_sort(int *arr, int n) {
             int temp = arr[i];
             arr[i] = arr[min_idx];
             arr[min_idx] = temp;
+            SORT_SWAPS(1);
         }
     }
 }
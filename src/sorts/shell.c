@@ -1,15 +1,129 @@
+#include <math.h>
+#include <stdlib.h>
 #include "../../include/sorts.h"
+#include "../../include/sort_instrument.h"
 
-void shell_sort(int *arr, int n) {
-    for (int gap = n / 2; gap > 0; gap /= 2) {
+// Enough for every sequence below 2^31, including Pratt's 2^p * 3^q (~320 terms)
+#define SHELL_MAX_GAPS 512
+
+void shell_sort_with_gaps(int *arr, int n, const int *gaps, int gap_count) {
+    if (arr == NULL || n <= 1 || gaps == NULL) {
+        return;
+    }
+
+    for (int g = gap_count - 1; g >= 0; g--) {
+        int gap = gaps[g];
+        if (gap <= 0 || gap >= n) {
+            continue;
+        }
         for (int i = gap; i < n; i++) {
             int temp = arr[i];
             int j = i;
-            while (j >= gap && arr[j - gap] > temp) {
+            SORT_READS(1);
+            while (j >= gap && SORT_CMP(1, arr[j - gap] > temp)) {
                 arr[j] = arr[j - gap];
+                SORT_MOVES(1);
                 j -= gap;
             }
             arr[j] = temp;
+            SORT_WRITES(1);
         }
     }
 }
+
+static int insert_sorted_gap(int *gaps, int count, int gap) {
+    if (count >= SHELL_MAX_GAPS) {
+        return count;
+    }
+    int i = count;
+    while (i > 0 && gaps[i - 1] > gap) {
+        gaps[i] = gaps[i - 1];
+        i--;
+    }
+    gaps[i] = gap;
+    return count + 1;
+}
+
+// Fill `gaps` in ascending order with every term of `sequence` below n
+static int build_gaps(ShellGapSequence sequence, int n, int *gaps) {
+    int count = 0;
+
+    switch (sequence) {
+        case SHELL_GAPS_SHELL:
+            // n/2, n/4, ..., 1 (stored ascending)
+            for (int gap = n / 2; gap > 0; gap /= 2) {
+                count = insert_sorted_gap(gaps, count, gap);
+            }
+            break;
+
+        case SHELL_GAPS_CIURA: {
+            // Ciura's measured terms, extended by h(k) = floor(2.25 * h(k-1))
+            static const int ciura[] = {1, 4, 10, 23, 57, 132, 301, 701, 1750};
+            long long gap = 0;
+            for (int i = 0; i < (int)(sizeof(ciura) / sizeof(ciura[0])) && ciura[i] < n; i++) {
+                gap = ciura[i];
+                gaps[count++] = (int)gap;
+            }
+            if (gap == 1750) {
+                for (gap = (long long)(gap * 2.25); gap < n; gap = (long long)(gap * 2.25)) {
+                    gaps[count++] = (int)gap;
+                }
+            }
+            break;
+        }
+
+        case SHELL_GAPS_TOKUDA:
+            // h(k) = ceil((9^k - 4^k) / (5 * 4^(k-1))) = ceil((9 * 2.25^(k-1) - 4) / 5)
+            for (int k = 1; count < SHELL_MAX_GAPS; k++) {
+                double gap = ceil((9.0 * pow(2.25, k - 1) - 4.0) / 5.0);
+                if (gap >= n) {
+                    break;
+                }
+                gaps[count++] = (int)gap;
+            }
+            break;
+
+        case SHELL_GAPS_SEDGEWICK:
+            // Sedgewick 1986: 9 * (4^k - 2^k) + 1 interleaved with 4^k - 3 * 2^k + 1
+            for (int k = 0; k < 31; k++) {
+                long long p4 = 1LL << (2 * k);
+                long long p2 = 1LL << k;
+                long long a = 9 * (p4 - p2) + 1;
+                long long b = p4 - 3 * p2 + 1;
+                if (a < n) {
+                    count = insert_sorted_gap(gaps, count, (int)a);
+                }
+                if (k >= 2 && b < n) {
+                    count = insert_sorted_gap(gaps, count, (int)b);
+                }
+                if (a >= n && b >= n) {
+                    break;
+                }
+            }
+            break;
+
+        case SHELL_GAPS_PRATT:
+            // Every 3-smooth number 2^p * 3^q below n
+            for (long long p3 = 1; p3 < n; p3 *= 3) {
+                for (long long gap = p3; gap < n; gap *= 2) {
+                    count = insert_sorted_gap(gaps, count, (int)gap);
+                }
+            }
+            break;
+    }
+
+    return count;
+}
+
+void shell_sort_sequence(int *arr, int n, ShellGapSequence sequence) {
+    if (arr == NULL || n <= 1) {
+        return;
+    }
+    int gaps[SHELL_MAX_GAPS];
+    int count = build_gaps(sequence, n, gaps);
+    shell_sort_with_gaps(arr, n, gaps, count);
+}
+
+void shell_sort(int *arr, int n) {
+    shell_sort_sequence(arr, n, SHELL_GAPS_SHELL);
+}
@@ -0,0 +1,146 @@
+#include <limits.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../include/sort_tuning.h"
+#include "../../include/sort_kernels.h"
+
+static const struct {
+    const char *name;
+    int default_value;
+    int min_value;
+    int max_value;
+} TUNABLES[SORT_TUNING_COUNT] = {
+    {"quick_small_sort",         SORT_KERNEL_MAX, 4, 256},
+    {"merge_run_size",           SORT_KERNEL_MAX, 4, 256},
+    {"intro_insertion",          24,              4, 256},
+    {"bucket_target",            32,              4, 4096},
+    {"radix_digit_bits",         8,               8, 16},
+    {"radix_wide_cutoff",        0,               0, INT_MAX},
+    {"parallel_quick_cutoff",    16384,           1024, INT_MAX},
+    {"parallel_quick_grain",     16384,           1024, INT_MAX},
+    {"parallel_merge_cutoff",    65536,           1024, INT_MAX},
+    {"parallel_radix_cutoff",    65536,           1024, INT_MAX},
+    {"parallel_sample_cutoff",   65536,           1024, INT_MAX},
+    {"parallel_counting_cutoff", 65536,           1024, INT_MAX},
+};
+
+static int values[SORT_TUNING_COUNT];
+
+// Defaults, then the SORT_TUNING profile, before the first read or write
+static pthread_once_t values_once = PTHREAD_ONCE_INIT;
+
+static bool valid_param(SortTunable param) {
+    return param >= 0 && param < SORT_TUNING_COUNT;
+}
+
+static int store_value(SortTunable param, int value) {
+    if (value < TUNABLES[param].min_value) {
+        value = TUNABLES[param].min_value;
+    }
+    if (value > TUNABLES[param].max_value) {
+        value = TUNABLES[param].max_value;
+    }
+    // The radix engine only has 8-, 11- and 16-bit digit loops
+    if (param == TUNE_RADIX_DIGIT_BITS) {
+        value = value < 10 ? 8 : value < 14 ? 11 : 16;
+    }
+    values[param] = value;
+    return value;
+}
+
+static void reset_values(void) {
+    for (int p = 0; p < SORT_TUNING_COUNT; p++) {
+        values[p] = TUNABLES[p].default_value;
+    }
+}
+
+static int apply_profile(const char *path);
+
+static void initialize_values(void) {
+    reset_values();
+    const char *path = getenv("SORT_TUNING");
+    if (path != NULL && *path != '\0' && apply_profile(path) < 0) {
+        fprintf(stderr, "sort_tuning: cannot read SORT_TUNING profile %s\n", path);
+    }
+}
+
+int sort_tuning_get(SortTunable param) {
+    pthread_once(&values_once, initialize_values);
+    return valid_param(param) ? values[param] : 0;
+}
+
+int sort_tuning_set(SortTunable param, int value) {
+    pthread_once(&values_once, initialize_values);
+    return valid_param(param) ? store_value(param, value) : 0;
+}
+
+void sort_tuning_reset(void) {
+    pthread_once(&values_once, initialize_values);
+    reset_values();
+}
+
+const char *sort_tuning_name(SortTunable param) {
+    return valid_param(param) ? TUNABLES[param].name : "unknown";
+}
+
+int sort_tuning_default(SortTunable param) {
+    return valid_param(param) ? TUNABLES[param].default_value : 0;
+}
+
+static int apply_profile(const char *path) {
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) {
+        return -1;
+    }
+
+    int applied = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        line[strcspn(line, "#\r\n")] = '\0';
+        char name[64];
+        long long value;
+        if (sscanf(line, " %63[A-Za-z0-9_] = %lld", name, &value) != 2) {
+            continue;
+        }
+        for (int p = 0; p < SORT_TUNING_COUNT; p++) {
+            if (strcmp(name, TUNABLES[p].name) == 0) {
+                if (value > INT_MAX) {
+                    value = INT_MAX;
+                }
+                store_value((SortTunable)p, value < INT_MIN ? INT_MIN : (int)value);
+                applied++;
+                break;
+            }
+        }
+    }
+    fclose(fp);
+    return applied;
+}
+
+int sort_tuning_load(const char *path) {
+    pthread_once(&values_once, initialize_values);
+    return apply_profile(path);
+}
+
+int sort_tuning_save(const char *path, const char *comment) {
+    pthread_once(&values_once, initialize_values);
+    FILE *fp = fopen(path, "w");
+    if (fp == NULL) {
+        return -1;
+    }
+    for (const char *line = comment; line != NULL && *line != '\0'; ) {
+        size_t length = strcspn(line, "\n");
+        fprintf(fp, "# %.*s\n", (int)length, line);
+        line += length;
+        if (*line == '\n') {
+            line++;
+        }
+    }
+    for (int p = 0; p < SORT_TUNING_COUNT; p++) {
+        fprintf(fp, "%s = %d\n", TUNABLES[p].name, values[p]);
+    }
+    return fclose(fp) == 0 ? 0 : -1;
+}
@@ -0,0 +1,134 @@
+#include <math.h>
+#include "../include/sweep_planner.h"
+
+// Runs shorter than this are dominated by timer and call overhead; they anchor but do not fit
+#define SWEEP_FIT_MIN_SECONDS 1e-4
+// Bounds on a fitted exponent (cache cliffs can make two points look steeper than the trend)
+#define SWEEP_FIT_MIN_EXPONENT 0.5
+#define SWEEP_FIT_MAX_EXPONENT 3.0
+// A single case may stretch its time budget by at most this many base budgets
+#define SWEEP_PLANNER_MAX_EXTENSION 4.0
+
+void sweep_fit_init(SweepFit *fit, double prior_exponent) {
+    fit->count = 0;
+    fit->prior_exponent = prior_exponent;
+}
+
+void sweep_fit_add(SweepFit *fit, int n, double seconds) {
+    if (fit->count >= SWEEP_FIT_MAX_POINTS || n <= 0 || seconds < 0.0) {
+        return;
+    }
+    fit->sizes[fit->count] = n;
+    fit->seconds[fit->count] = seconds;
+    fit->count++;
+}
+
+// Slope in log-log space between the two largest reliably timed sizes
+static double fit_exponent(const SweepFit *fit) {
+    int upper = -1;
+    for (int i = fit->count - 1; i >= 0; i--) {
+        if (fit->seconds[i] < SWEEP_FIT_MIN_SECONDS) {
+            break;
+        }
+        if (upper < 0) {
+            upper = i;
+        } else if (fit->sizes[i] < fit->sizes[upper]) {
+            double k = log(fit->seconds[upper] / fit->seconds[i]) /
+                       log((double)fit->sizes[upper] / (double)fit->sizes[i]);
+            return fmin(fmax(k, SWEEP_FIT_MIN_EXPONENT), SWEEP_FIT_MAX_EXPONENT);
+        }
+    }
+    return fit->prior_exponent;
+}
+
+double sweep_fit_predict(const SweepFit *fit, int n) {
+    if (fit->count == 0) {
+        return -1.0;
+    }
+    int last = fit->count - 1;
+    double seconds = fmax(fit->seconds[last], SWEEP_FIT_MIN_SECONDS);
+    return seconds * pow((double)n / (double)fit->sizes[last], fit_exponent(fit));
+}
+
+/* ========== Budgets ========== */
+
+static double algorithm_budget = 0.0;
+static double total_budget = 0.0;
+static double algorithm_spent = 0.0;
+static bool algorithm_cut = false;
+static double reserve = 0.0;
+static SweepPlannerTotals totals;
+
+void sweep_planner_set_budgets(double per_algorithm, double total) {
+    algorithm_budget = per_algorithm > 0.0 ? per_algorithm : 0.0;
+    total_budget = total > 0.0 ? total : 0.0;
+    algorithm_spent = 0.0;
+    algorithm_cut = false;
+    reserve = 0.0;
+    totals = (SweepPlannerTotals){0, 0, 0.0, 0.0, 0.0};
+}
+
+bool sweep_planner_active(void) {
+    return algorithm_budget > 0.0 || total_budget > 0.0;
+}
+
+double sweep_planner_algorithm_budget(void) {
+    return algorithm_budget;
+}
+
+double sweep_planner_total_budget(void) {
+    return total_budget;
+}
+
+void sweep_planner_begin_algorithm(void) {
+    algorithm_spent = 0.0;
+    algorithm_cut = false;
+}
+
+void sweep_planner_end_algorithm(void) {
+    if (algorithm_cut && algorithm_budget > algorithm_spent) {
+        reserve += algorithm_budget - algorithm_spent;
+    }
+    algorithm_spent = 0.0;
+    algorithm_cut = false;
+}
+
+static double total_remaining(void) {
+    return total_budget > 0.0 ? total_budget - totals.spent : INFINITY;
+}
+
+double sweep_planner_remaining(void) {
+    double remaining = total_remaining();
+    if (algorithm_budget > 0.0) {
+        remaining = fmin(remaining, algorithm_budget - algorithm_spent);
+    }
+    return remaining;
+}
+
+void sweep_planner_skip(double projected_seconds) {
+    algorithm_cut = true;
+    totals.skipped_cases++;
+    if (projected_seconds < 0.0) {
+        totals.unprojected_cases++;
+    } else {
+        totals.skipped_seconds += projected_seconds;
+    }
+}
+
+double sweep_planner_grant(double base_budget) {
+    double grant = fmin(reserve, SWEEP_PLANNER_MAX_EXTENSION * base_budget);
+    grant = fmin(grant, total_remaining() - base_budget);
+    return grant > 0.0 ? grant : 0.0;
+}
+
+void sweep_planner_charge(double seconds, double base_budget, double granted) {
+    double from_reserve = fmin(fmax(seconds - base_budget, 0.0), granted);
+    reserve -= from_reserve;
+    totals.reserve_spent += from_reserve;
+    algorithm_spent += seconds - from_reserve;
+    totals.spent += seconds;
+}
+
+SweepPlannerTotals sweep_planner_totals(void) {
+    return totals;
+}
@@ -0,0 +1,356 @@
+// sched_setaffinity and the CPU_* macros are GNU extensions
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "../include/thread_pool.h"
+
+#define DEQUE_INITIAL_CAPACITY 64
+
+typedef struct {
+    ThreadPoolTaskFn fn;
+    void *ctx;
+    int begin;
+    int end;
+} PoolTask;
+
+// Tasks live in tasks[head, tail); the owner works at the tail, thieves at the head
+typedef struct {
+    pthread_mutex_t lock;
+    PoolTask *tasks;
+    int head;
+    int tail;
+    int capacity;
+} WorkDeque;
+
+typedef struct {
+    ThreadPool *pool;
+    int index;
+} WorkerArg;
+
+struct ThreadPool {
+    int threads;
+    pthread_t *workers;
+    WorkerArg *worker_args;
+    WorkDeque *deques;
+    atomic_int pending;         // Submitted but not yet finished tasks
+    atomic_bool shutdown;
+    pthread_mutex_t idle_lock;
+    pthread_cond_t idle_cond;
+};
+
+static _Thread_local ThreadPool *current_pool = NULL;
+static _Thread_local int current_index = 0;
+
+int thread_pool_default_threads(void) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 0 ? (int)cpus : 1;
+}
+
+/* ========== CPU pinning ========== */
+
+#ifdef __linux__
+
+// CPUs of the affinity mask seen by thread_pool_pin_threads (0: pinning off)
+static int pin_cpus[CPU_SETSIZE];
+static int pin_cpu_count = 0;
+
+static bool pin_to_slot(int slot) {
+    if (pin_cpu_count == 0) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(pin_cpus[slot % pin_cpu_count], &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;   // 0: the calling thread
+}
+
+int thread_pool_pin_threads(void) {
+    cpu_set_t mask;
+    if (pin_cpu_count == 0) {
+        if (sched_getaffinity(0, sizeof(mask), &mask) != 0) {
+            return -1;
+        }
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &mask)) {
+                pin_cpus[pin_cpu_count++] = cpu;
+            }
+        }
+    }
+    if (!pin_to_slot(0)) {
+        pin_cpu_count = 0;
+        return -1;
+    }
+    return pin_cpus[0];
+}
+
+#else
+
+static bool pin_to_slot(int slot) {
+    (void)slot;
+    return false;
+}
+
+int thread_pool_pin_threads(void) {
+    return -1;
+}
+
+#endif
+
+static bool deque_push(WorkDeque *deque, PoolTask task) {
+    pthread_mutex_lock(&deque->lock);
+    if (deque->tail == deque->capacity) {
+        if (deque->head > 0) {
+            // Reclaim the slots left behind by thieves before growing
+            int live = deque->tail - deque->head;
+            memmove(deque->tasks, deque->tasks + deque->head, live * sizeof(PoolTask));
+            deque->head = 0;
+            deque->tail = live;
+        } else {
+            int new_capacity = deque->capacity * 2;
+            PoolTask *grown = (PoolTask *)realloc(deque->tasks, new_capacity * sizeof(PoolTask));
+            if (grown == NULL) {
+                pthread_mutex_unlock(&deque->lock);
+                return false;
+            }
+            deque->tasks = grown;
+            deque->capacity = new_capacity;
+        }
+    }
+    deque->tasks[deque->tail++] = task;
+    pthread_mutex_unlock(&deque->lock);
+    return true;
+}
+
+static bool deque_pop(WorkDeque *deque, PoolTask *task) {
+    bool found = false;
+    pthread_mutex_lock(&deque->lock);
+    if (deque->tail > deque->head) {
+        *task = deque->tasks[--deque->tail];
+        found = true;
+        if (deque->tail == deque->head) {
+            deque->head = deque->tail = 0;
+        }
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return found;
+}
+
+static bool deque_steal(WorkDeque *deque, PoolTask *task) {
+    bool found = false;
+    // Skip victims that are busy or empty instead of queueing on their lock
+    if (pthread_mutex_trylock(&deque->lock) != 0) {
+        return false;
+    }
+    if (deque->tail > deque->head) {
+        *task = deque->tasks[deque->head++];
+        found = true;
+        if (deque->tail == deque->head) {
+            deque->head = deque->tail = 0;
+        }
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return found;
+}
+
+static bool find_task(ThreadPool *pool, int index, PoolTask *task) {
+    if (deque_pop(&pool->deques[index], task)) {
+        return true;
+    }
+    for (int k = 1; k < pool->threads; k++) {
+        int victim = (index + k) % pool->threads;
+        if (deque_steal(&pool->deques[victim], task)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void run_until_idle(ThreadPool *pool, int index) {
+    PoolTask task;
+    while (atomic_load_explicit(&pool->pending, memory_order_acquire) > 0) {
+        if (find_task(pool, index, &task)) {
+            task.fn(pool, task.ctx, task.begin, task.end);
+            atomic_fetch_sub_explicit(&pool->pending, 1, memory_order_acq_rel);
+        } else {
+            sched_yield();
+        }
+    }
+}
+
+static void *worker_main(void *arg) {
+    WorkerArg *worker = (WorkerArg *)arg;
+    ThreadPool *pool = worker->pool;
+
+    current_pool = pool;
+    current_index = worker->index;
+    pin_to_slot(worker->index);
+
+    for (;;) {
+        pthread_mutex_lock(&pool->idle_lock);
+        while (!atomic_load(&pool->shutdown) && atomic_load(&pool->pending) == 0) {
+            pthread_cond_wait(&pool->idle_cond, &pool->idle_lock);
+        }
+        pthread_mutex_unlock(&pool->idle_lock);
+
+        if (atomic_load(&pool->shutdown)) {
+            break;
+        }
+        run_until_idle(pool, worker->index);
+    }
+    return NULL;
+}
+
+ThreadPool *thread_pool_create(int threads) {
+    if (threads < 1) {
+        threads = 1;
+    }
+
+    ThreadPool *pool = (ThreadPool *)calloc(1, sizeof(ThreadPool));
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    pool->threads = threads;
+    pool->deques = (WorkDeque *)calloc(threads, sizeof(WorkDeque));
+    pool->workers = (pthread_t *)calloc(threads, sizeof(pthread_t));
+    pool->worker_args = (WorkerArg *)calloc(threads, sizeof(WorkerArg));
+    if (pool->deques == NULL || pool->workers == NULL || pool->worker_args == NULL) {
+        free(pool->deques);
+        free(pool->workers);
+        free(pool->worker_args);
+        free(pool);
+        return NULL;
+    }
+
+    atomic_init(&pool->pending, 0);
+    atomic_init(&pool->shutdown, false);
+    pthread_mutex_init(&pool->idle_lock, NULL);
+    pthread_cond_init(&pool->idle_cond, NULL);
+
+    int created_deques = 0;
+    for (; created_deques < threads; created_deques++) {
+        WorkDeque *deque = &pool->deques[created_deques];
+        deque->tasks = (PoolTask *)malloc(DEQUE_INITIAL_CAPACITY * sizeof(PoolTask));
+        if (deque->tasks == NULL) {
+            break;
+        }
+        deque->capacity = DEQUE_INITIAL_CAPACITY;
+        pthread_mutex_init(&deque->lock, NULL);
+    }
+
+    // Worker 0 is whoever calls thread_pool_wait, so only threads - 1 are spawned
+    int spawned = 1;
+    if (created_deques == threads) {
+        for (; spawned < threads; spawned++) {
+            pool->worker_args[spawned].pool = pool;
+            pool->worker_args[spawned].index = spawned;
+            if (pthread_create(&pool->workers[spawned], NULL, worker_main,
+                               &pool->worker_args[spawned]) != 0) {
+                break;
+            }
+        }
+    }
+
+    if (created_deques != threads || spawned != threads) {
+        pool->threads = spawned;  // Only join what actually started
+        atomic_store(&pool->shutdown, true);
+        pthread_mutex_lock(&pool->idle_lock);
+        pthread_cond_broadcast(&pool->idle_cond);
+        pthread_mutex_unlock(&pool->idle_lock);
+        for (int i = 1; i < spawned; i++) {
+            pthread_join(pool->workers[i], NULL);
+        }
+        for (int i = 0; i < created_deques; i++) {
+            pthread_mutex_destroy(&pool->deques[i].lock);
+            free(pool->deques[i].tasks);
+        }
+        pthread_mutex_destroy(&pool->idle_lock);
+        pthread_cond_destroy(&pool->idle_cond);
+        free(pool->deques);
+        free(pool->workers);
+        free(pool->worker_args);
+        free(pool);
+        return NULL;
+    }
+
+    return pool;
+}
+
+void thread_pool_destroy(ThreadPool *pool) {
+    if (pool == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->idle_lock);
+    atomic_store(&pool->shutdown, true);
+    pthread_cond_broadcast(&pool->idle_cond);
+    pthread_mutex_unlock(&pool->idle_lock);
+
+    for (int i = 1; i < pool->threads; i++) {
+        pthread_join(pool->workers[i], NULL);
+    }
+
+    for (int i = 0; i < pool->threads; i++) {
+        pthread_mutex_destroy(&pool->deques[i].lock);
+        free(pool->deques[i].tasks);
+    }
+    pthread_mutex_destroy(&pool->idle_lock);
+    pthread_cond_destroy(&pool->idle_cond);
+
+    free(pool->deques);
+    free(pool->workers);
+    free(pool->worker_args);
+    free(pool);
+}
+
+int thread_pool_size(const ThreadPool *pool) {
+    return pool != NULL ? pool->threads : 1;
+}
+
+int thread_pool_worker_index(const ThreadPool *pool) {
+    return (pool != NULL && current_pool == pool) ? current_index : 0;
+}
+
+void thread_pool_submit(ThreadPool *pool, ThreadPoolTaskFn fn, void *ctx, int begin, int end) {
+    PoolTask task = {fn, ctx, begin, end};
+    int index = thread_pool_worker_index(pool);
+
+    int previous = atomic_fetch_add_explicit(&pool->pending, 1, memory_order_acq_rel);
+    if (!deque_push(&pool->deques[index], task)) {
+        // Out of memory for the queue: run inline rather than lose work
+        fn(pool, ctx, begin, end);
+        atomic_fetch_sub_explicit(&pool->pending, 1, memory_order_acq_rel);
+        return;
+    }
+
+    if (previous == 0 && pool->threads > 1) {
+        pthread_mutex_lock(&pool->idle_lock);
+        pthread_cond_broadcast(&pool->idle_cond);
+        pthread_mutex_unlock(&pool->idle_lock);
+    }
+}
+
+void thread_pool_wait(ThreadPool *pool) {
+    ThreadPool *saved_pool = current_pool;
+    int saved_index = current_index;
+
+    current_pool = pool;
+    current_index = 0;
+    run_until_idle(pool, 0);
+
+    current_pool = saved_pool;
+    current_index = saved_index;
+}
+
+void thread_pool_parallel_for(ThreadPool *pool, int count, ThreadPoolTaskFn fn, void *ctx) {
+    // Submitted in reverse so worker 0 pops index 0 first while others steal the rest
+    for (int i = count - 1; i >= 0; i--) {
+        thread_pool_submit(pool, fn, ctx, i, i);
+    }
+    thread_pool_wait(pool);
+}
@@ -0,0 +1,323 @@
+// gethostname and the cache-size sysconf names are outside strict POSIX
+#define _DEFAULT_SOURCE
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "../include/tuner.h"
+#include "../include/benchmark.h"
+#include "../include/data_generator.h"
+#include "../include/measure.h"
+#include "../include/sort_tuning.h"
+#include "../include/sorts.h"
+#include "../include/thread_pool.h"
+#include "../include/verify.h"
+
+#define ARRAY_SIZE(arr) (int)(sizeof(arr) / sizeof((arr)[0]))
+
+// Input for the engine-size sweeps: beyond L2 on most hosts, still quick to sort
+#define TUNE_SWEEP_SIZE 1000000
+// Crossover ladder: powers of two over this range
+#define TUNE_LADDER_MIN 4096
+#define TUNE_LADDER_MAX (4 << 20)
+#define TUNE_MAX_CANDIDATES 8
+
+static int tuner_threads = 1;
+
+/* ========== Engines Under Test ========== */
+
+static void radix_sort_8bit(int *arr, int n) {
+    radix_sort_bits(arr, n, 8, 1);
+}
+
+static void radix_sort_wide(int *arr, int n) {
+    radix_sort_bits(arr, n, sort_tuning_get(TUNE_RADIX_DIGIT_BITS), 1);
+}
+
+static void parallel_quick(int *arr, int n) {
+    parallel_quick_sort(arr, n, tuner_threads);
+}
+
+static void parallel_merge(int *arr, int n) {
+    parallel_merge_sort(arr, n, tuner_threads);
+}
+
+static void parallel_radix(int *arr, int n) {
+    parallel_radix_sort(arr, n, tuner_threads);
+}
+
+static void parallel_sample(int *arr, int n) {
+    parallel_sample_sort(arr, n, tuner_threads);
+}
+
+static void counting_serial(int *arr, int n) {
+    counting_sort_range(arr, n, 1);
+}
+
+static void counting_parallel(int *arr, int n) {
+    counting_sort_range(arr, n, tuner_threads);
+}
+
+// One engine parameter swept over candidate values (the default is always a candidate)
+typedef struct {
+    SortTunable param;
+    const char *engine;
+    void (*sort_func)(int*, int);
+    int candidates[TUNE_MAX_CANDIDATES];
+    int candidate_count;
+    bool parallel;
+} SizeSweep;
+
+static const SizeSweep SIZE_SWEEPS[] = {
+    {TUNE_QUICK_SMALL_SORT, "QuickSort", quick_sort, {8, 16, 24, 32, 48, 64, 96, 128}, 8, false},
+    {TUNE_MERGE_RUN_SIZE, "MergeSortBottomUp", merge_sort_bottom_up, {8, 16, 32, 64, 128, 256}, 6, false},
+    {TUNE_INTRO_INSERTION, "IntroSort", intro_sort, {8, 12, 16, 24, 32, 48, 64}, 7, false},
+    {TUNE_BUCKET_TARGET, "BucketSort", bucket_sort, {8, 16, 32, 64, 128, 256}, 6, false},
+    {TUNE_RADIX_DIGIT_BITS, "RadixSort", radix_sort, {8, 11, 16}, 3, false},
+    // Runs after the small-sort cutoff, at the default serial cutoff (well below the sweep size)
+    {TUNE_PARALLEL_QUICK_GRAIN, "ParallelQuickSort", parallel_quick,
+     {2048, 4096, 8192, 16384, 32768, 65536, 131072}, 7, true},
+};
+
+// The alternative engine takes over from the cutoff parameter up
+typedef struct {
+    SortTunable param;
+    const char *baseline_name;
+    void (*baseline)(int*, int);
+    const char *alternative_name;
+    void (*alternative)(int*, int);
+    bool parallel;
+} Crossover;
+
+static const Crossover CROSSOVERS[] = {
+    {TUNE_RADIX_WIDE_CUTOFF, "RadixSort8", radix_sort_8bit, "RadixSortWide", radix_sort_wide, false},
+    {TUNE_PARALLEL_QUICK_CUTOFF, "QuickSort", quick_sort, "ParallelQuickSort", parallel_quick, true},
+    {TUNE_PARALLEL_MERGE_CUTOFF, "MergeSortBottomUp", merge_sort_bottom_up,
+     "ParallelMergeSort", parallel_merge, true},
+    {TUNE_PARALLEL_RADIX_CUTOFF, "RadixSort", radix_sort, "ParallelRadixSort", parallel_radix, true},
+    {TUNE_PARALLEL_SAMPLE_CUTOFF, "IntroSort", intro_sort, "ParallelSampleSort", parallel_sample, true},
+    {TUNE_PARALLEL_COUNTING_CUTOFF, "CountingSortRange", counting_serial,
+     "ParallelCountingSort", counting_parallel, true},
+};
+
+/* ========== Timing ========== */
+
+typedef struct {
+    void (*sort_func)(int*, int);
+    int *arr;
+    const int *input;
+    int n;
+} TunerTrial;
+
+static double tuner_trial(void *arg) {
+    TunerTrial *trial = (TunerTrial *)arg;
+    memcpy(trial->arr, trial->input, (size_t)trial->n * sizeof(int));
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    trial->sort_func(trial->arr, trial->n);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+// Median seconds per run, or -1 if the engine got the wrong result
+static double time_engine(void (*sort_func)(int*, int), int *arr, const int *input, int n,
+                          Fingerprint fingerprint, TimingStats *stats) {
+    TunerTrial trial = {sort_func, arr, input, n};
+    *stats = measure_trials(tuner_trial, &trial);
+    if (stats->runs == 0 || find_unsorted_int(arr, n, 1) >= 0 ||
+        !fingerprint_equal(fingerprint_keys(arr, n, sizeof(int), 1), fingerprint)) {
+        return -1.0;
+    }
+    return stats->median;
+}
+
+static void write_row(FILE *csv, SortTunable param, const char *engine, const char *value,
+                      int n, const TimingStats *stats) {
+    fprintf(csv, "%s,%s,%s,%d,%.9f,%d,%.9f\n", sort_tuning_name(param), engine, value, n,
+            stats->median, stats->runs, stats->ci95);
+}
+
+/* ========== Parameter Sweeps ========== */
+
+static void tune_size_parameter(const SizeSweep *sweep, FILE *csv, int *arr, const int *input,
+                                Fingerprint fingerprint) {
+    int default_value = sort_tuning_default(sweep->param);
+    printf("Tuning %s (%s, n=%d)\n", sort_tuning_name(sweep->param), sweep->engine, TUNE_SWEEP_SIZE);
+
+    int best_value = sort_tuning_get(sweep->param);
+    double best_time = -1.0;
+    double default_time = -1.0;
+    for (int c = 0; c < sweep->candidate_count; c++) {
+        int value = sort_tuning_set(sweep->param, sweep->candidates[c]);
+        TimingStats stats;
+        double time = time_engine(sweep->sort_func, arr, input, TUNE_SWEEP_SIZE, fingerprint, &stats);
+        if (time < 0.0) {
+            printf("  %6d: [FAIL - WRONG RESULT]\n", value);
+            continue;
+        }
+        printf("  %6d: %.4fs\n", value, time);
+
+        char label[16];
+        snprintf(label, sizeof(label), "%d", value);
+        write_row(csv, sweep->param, sweep->engine, label, TUNE_SWEEP_SIZE, &stats);
+
+        if (value == default_value) {
+            default_time = time;
+        }
+        if (best_time < 0.0 || time < best_time) {
+            best_time = time;
+            best_value = value;
+        }
+    }
+
+    sort_tuning_set(sweep->param, best_value);
+    if (best_time > 0.0 && default_time > 0.0) {
+        printf("  -> %d (default %d; %.1f%% faster)\n\n", best_value, default_value,
+               100.0 * (1.0 - best_time / default_time));
+    } else {
+        printf("  -> %d\n\n", best_value);
+    }
+}
+
+static void tune_crossover(const Crossover *crossover, FILE *csv, int *arr, int *input) {
+    const char *name = sort_tuning_name(crossover->param);
+    printf("Tuning %s (%s vs %s, n=%d..%d)\n", name, crossover->baseline_name,
+           crossover->alternative_name, TUNE_LADDER_MIN, TUNE_LADDER_MAX);
+
+    // Lowest cutoff while measuring, so the parallel engines never fall back on their own.
+    // Their other parameters (the quick sort task grain) are already tuned by now.
+    int previous = sort_tuning_get(crossover->param);
+    if (crossover->parallel) {
+        sort_tuning_set(crossover->param, 0);
+    }
+
+    int sizes[32];
+    bool alternative_wins[32];
+    int count = 0;
+    for (int n = TUNE_LADDER_MIN; n <= TUNE_LADDER_MAX && count < ARRAY_SIZE(sizes); n *= 2) {
+        generate_data(input, n, RANDOM);
+        Fingerprint fingerprint = fingerprint_keys(input, n, sizeof(int), 1);
+        TimingStats base_stats;
+        TimingStats alt_stats;
+        double base = time_engine(crossover->baseline, arr, input, n, fingerprint, &base_stats);
+        double alt = time_engine(crossover->alternative, arr, input, n, fingerprint, &alt_stats);
+        if (base < 0.0 || alt < 0.0) {
+            printf("  %8d: [FAIL - WRONG RESULT]\n", n);
+            continue;
+        }
+        printf("  %8d: %s %.5fs, %s %.5fs\n", n, crossover->baseline_name, base,
+               crossover->alternative_name, alt);
+        write_row(csv, crossover->param, crossover->baseline_name, "baseline", n, &base_stats);
+        write_row(csv, crossover->param, crossover->alternative_name, "alternative", n, &alt_stats);
+
+        sizes[count] = n;
+        alternative_wins[count] = alt < base;
+        count++;
+    }
+
+    // Smallest size from which the alternative wins at every larger size measured
+    int cutoff = INT_MAX;
+    for (int i = count - 1; i >= 0 && alternative_wins[i]; i--) {
+        cutoff = sizes[i];
+    }
+    if (count == 0) {
+        cutoff = previous;
+    }
+
+    cutoff = sort_tuning_set(crossover->param, cutoff);
+    if (cutoff == INT_MAX) {
+        printf("  -> never (%s wins up to n=%d)\n\n", crossover->baseline_name, TUNE_LADDER_MAX);
+    } else {
+        printf("  -> %d (default %d)\n\n", cutoff, sort_tuning_default(crossover->param));
+    }
+}
+
+static long cache_kib(int name) {
+    long bytes = sysconf(name);
+    return bytes > 0 ? bytes / 1024 : 0;
+}
+
+int run_tuning(const char *profile_path) {
+    printf("=== Host Tuning ===\n\n");
+
+    tuner_threads = benchmark_thread_count();
+    sort_tuning_reset();
+
+    FILE *csv = fopen("results/tuning.csv", "w");
+    if (csv == NULL) {
+        printf("Error: Could not open results/tuning.csv for writing\n");
+        return -1;
+    }
+    fprintf(csv, "Parameter,Engine,Value,Size,Time,Runs,CI95\n");
+
+    size_t bytes = (size_t)TUNE_LADDER_MAX * sizeof(int);
+    int *arr = (int *)malloc(bytes);
+    int *input = (int *)malloc(bytes);
+    if (arr == NULL || input == NULL) {
+        printf("Memory allocation failed\n");
+        free(arr);
+        free(input);
+        fclose(csv);
+        return -1;
+    }
+
+    generate_data(input, TUNE_SWEEP_SIZE, RANDOM);
+    Fingerprint fingerprint = fingerprint_keys(input, TUNE_SWEEP_SIZE, sizeof(int), 1);
+    for (int s = 0; s < ARRAY_SIZE(SIZE_SWEEPS); s++) {
+        if (SIZE_SWEEPS[s].parallel && tuner_threads <= 1) {
+            printf("Skipping %s: needs more than one thread (--threads)\n\n",
+                   sort_tuning_name(SIZE_SWEEPS[s].param));
+            continue;
+        }
+        tune_size_parameter(&SIZE_SWEEPS[s], csv, arr, input, fingerprint);
+    }
+
+    for (int c = 0; c < ARRAY_SIZE(CROSSOVERS); c++) {
+        const Crossover *crossover = &CROSSOVERS[c];
+        if (crossover->param == TUNE_RADIX_WIDE_CUTOFF && sort_tuning_get(TUNE_RADIX_DIGIT_BITS) == 8) {
+            printf("Skipping %s: 8-bit digits won, so there is no wide-digit crossover\n\n",
+                   sort_tuning_name(crossover->param));
+            continue;
+        }
+        if (crossover->parallel && tuner_threads <= 1) {
+            printf("Skipping %s: needs more than one thread (--threads)\n\n",
+                   sort_tuning_name(crossover->param));
+            continue;
+        }
+        tune_crossover(crossover, csv, arr, input);
+    }
+
+    free(arr);
+    free(input);
+    fclose(csv);
+
+    char host[256] = "unknown";
+    gethostname(host, sizeof(host) - 1);
+    time_t now = time(NULL);
+    char date[64] = "";
+    strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", localtime(&now));
+    char comment[512];
+    snprintf(comment, sizeof(comment),
+             "Sort tuning profile generated by ./bin/benchmark --tune\n"
+             "Host %s, %s, %d CPUs (%d threads), L1d %ld KiB, L2 %ld KiB, L3 %ld KiB\n"
+             "Load with --tuning FILE, sort_tuning_load(), or SORT_TUNING=FILE",
+             host, date, thread_pool_default_threads(), tuner_threads,
+             cache_kib(_SC_LEVEL1_DCACHE_SIZE), cache_kib(_SC_LEVEL2_CACHE_SIZE),
+             cache_kib(_SC_LEVEL3_CACHE_SIZE));
+
+    printf("Tuned profile:\n");
+    for (int p = 0; p < SORT_TUNING_COUNT; p++) {
+        printf("  %-26s %10d  (default %d)\n", sort_tuning_name((SortTunable)p),
+               sort_tuning_get((SortTunable)p), sort_tuning_default((SortTunable)p));
+    }
+
+    if (sort_tuning_save(profile_path, comment) != 0) {
+        printf("Error: Could not write %s\n", profile_path);
+        return -1;
+    }
+    printf("\nProfile written to %s; timings in results/tuning.csv\n", profile_path);
+    return 0;
+}
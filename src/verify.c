@@ -0,0 +1,194 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include "../include/verify.h"
+#include "../include/thread_pool.h"
+
+// Below this size a thread pool costs more than the scan
+#define VERIFY_PARALLEL_CUTOFF (1 << 20)
+// Slices per thread, so a slow worker does not hold up the whole scan
+#define VERIFY_SLICES_PER_THREAD 4
+
+typedef struct {
+    const char *arr;
+    int n;
+    size_t elem_size;
+    int (*compare)(const void *, const void *);
+    int slices;
+    Fingerprint *partial;       // One fingerprint per slice
+    int *first_unsorted;        // One result per slice (-1: sorted)
+} VerifyContext;
+
+static inline int slice_begin(const VerifyContext *ctx, int slice) {
+    return (int)((long long)ctx->n * slice / ctx->slices);
+}
+
+/*
+ * Runs task over every slice, on a pool when the input is large enough.
+ * Returns false only if the per-slice results cannot be allocated.
+ */
+static bool run_slices(VerifyContext *ctx, int threads, ThreadPoolTaskFn task) {
+    ThreadPool *pool = NULL;
+    if (threads > 1 && ctx->n >= VERIFY_PARALLEL_CUTOFF) {
+        pool = thread_pool_create(threads);
+    }
+    ctx->slices = pool != NULL ? threads * VERIFY_SLICES_PER_THREAD : 1;
+    ctx->partial = (Fingerprint *)malloc((size_t)ctx->slices * sizeof(Fingerprint));
+    ctx->first_unsorted = (int *)malloc((size_t)ctx->slices * sizeof(int));
+    if (ctx->partial == NULL || ctx->first_unsorted == NULL) {
+        free(ctx->partial);
+        free(ctx->first_unsorted);
+        thread_pool_destroy(pool);
+        return false;
+    }
+
+    if (pool != NULL) {
+        thread_pool_parallel_for(pool, ctx->slices, task, ctx);
+        thread_pool_destroy(pool);
+    } else {
+        task(NULL, ctx, 0, 0);
+    }
+    return true;
+}
+
+/* ========== Multiset fingerprint ========== */
+
+static inline uint64_t mix_a(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+static inline uint64_t mix_b(uint64_t x) {
+    x = (x ^ (x >> 33)) * 0xff51afd7ed558ccdULL;
+    x = (x ^ (x >> 33)) * 0xc4ceb9fe1a85ec53ULL;
+    return x ^ (x >> 33);
+}
+
+void fingerprint_update(Fingerprint *fp, const void *keys, int n, size_t key_size) {
+    if (n <= 0) {
+        return;
+    }
+    fp->count += (uint64_t)n;
+    if (key_size == sizeof(uint32_t)) {
+        const uint32_t *k32 = (const uint32_t *)keys;
+        for (int i = 0; i < n; i++) {
+            fp->sum += mix_a(k32[i]);
+            fp->xor_mix ^= mix_b(k32[i]);
+        }
+    } else {
+        const uint64_t *k64 = (const uint64_t *)keys;
+        for (int i = 0; i < n; i++) {
+            fp->sum += mix_a(k64[i]);
+            fp->xor_mix ^= mix_b(k64[i]);
+        }
+    }
+}
+
+static void fingerprint_task(ThreadPool *pool, void *arg, int slice, int unused) {
+    (void)pool;
+    (void)unused;
+    VerifyContext *ctx = (VerifyContext *)arg;
+    int begin = slice_begin(ctx, slice);
+    int end = slice_begin(ctx, slice + 1);
+    Fingerprint fp = {0, 0, 0};
+    fingerprint_update(&fp, ctx->arr + (size_t)begin * ctx->elem_size, end - begin, ctx->elem_size);
+    ctx->partial[slice] = fp;
+}
+
+Fingerprint fingerprint_keys(const void *arr, int n, size_t key_size, int threads) {
+    Fingerprint fp = {0, 0, 0};
+    if (arr == NULL || n <= 0 || (key_size != sizeof(uint32_t) && key_size != sizeof(uint64_t))) {
+        return fp;
+    }
+
+    VerifyContext ctx = {(const char *)arr, n, key_size, NULL, 1, NULL, NULL};
+    if (!run_slices(&ctx, threads, fingerprint_task)) {
+        // No room for per-slice results: one serial pass into a local slot
+        Fingerprint single;
+        ctx.slices = 1;
+        ctx.partial = &single;
+        fingerprint_task(NULL, &ctx, 0, 0);
+        return single;
+    }
+    for (int s = 0; s < ctx.slices; s++) {
+        fp.count += ctx.partial[s].count;
+        fp.sum += ctx.partial[s].sum;
+        fp.xor_mix ^= ctx.partial[s].xor_mix;
+    }
+    free(ctx.partial);
+    free(ctx.first_unsorted);
+    return fp;
+}
+
+bool fingerprint_equal(Fingerprint a, Fingerprint b) {
+    return a.count == b.count && a.sum == b.sum && a.xor_mix == b.xor_mix;
+}
+
+/* ========== Order check ========== */
+
+// Each slice also checks the pair that straddles its left boundary
+static void unsorted_int_task(ThreadPool *pool, void *arg, int slice, int unused) {
+    (void)pool;
+    (void)unused;
+    VerifyContext *ctx = (VerifyContext *)arg;
+    const int *arr = (const int *)(const void *)ctx->arr;
+    int begin = slice_begin(ctx, slice);
+    int end = slice_begin(ctx, slice + 1);
+    ctx->first_unsorted[slice] = -1;
+    for (int i = begin > 0 ? begin : 1; i < end; i++) {
+        if (arr[i - 1] > arr[i]) {
+            ctx->first_unsorted[slice] = i;
+            return;
+        }
+    }
+}
+
+static void unsorted_task(ThreadPool *pool, void *arg, int slice, int unused) {
+    (void)pool;
+    (void)unused;
+    VerifyContext *ctx = (VerifyContext *)arg;
+    int begin = slice_begin(ctx, slice);
+    int end = slice_begin(ctx, slice + 1);
+    ctx->first_unsorted[slice] = -1;
+    for (int i = begin > 0 ? begin : 1; i < end; i++) {
+        if (ctx->compare(ctx->arr + (size_t)(i - 1) * ctx->elem_size,
+                         ctx->arr + (size_t)i * ctx->elem_size) > 0) {
+            ctx->first_unsorted[slice] = i;
+            return;
+        }
+    }
+}
+
+static int find_unsorted_slices(VerifyContext *ctx, int threads, ThreadPoolTaskFn task) {
+    if (!run_slices(ctx, threads, task)) {
+        int single;
+        ctx->slices = 1;
+        ctx->first_unsorted = &single;
+        task(NULL, ctx, 0, 0);
+        return single;
+    }
+    int first = -1;
+    for (int s = 0; s < ctx->slices && first < 0; s++) {
+        first = ctx->first_unsorted[s];
+    }
+    free(ctx->partial);
+    free(ctx->first_unsorted);
+    return first;
+}
+
+int find_unsorted_int(const int *arr, int n, int threads) {
+    if (arr == NULL || n <= 1) {
+        return -1;
+    }
+    VerifyContext ctx = {(const char *)(const void *)arr, n, sizeof(int), NULL, 1, NULL, NULL};
+    return find_unsorted_slices(&ctx, threads, unsorted_int_task);
+}
+
+int find_unsorted(const void *arr, int n, size_t elem_size,
+                  int (*compare)(const void *, const void *), int threads) {
+    if (arr == NULL || n <= 1) {
+        return -1;
+    }
+    VerifyContext ctx = {(const char *)arr, n, elem_size, compare, 1, NULL, NULL};
+    return find_unsorted_slices(&ctx, threads, unsorted_task);
+}
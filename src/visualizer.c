@@ -22,6 +22,12 @@ typedef struct {
     bool seen[4];
 } PatternEntry;
 
+// Hygiene runs write a warm and a cold row per case (last column); the charts use the warm one
+static bool is_cold_row(const char *line) {
+    const char *comma = strrchr(line, ',');
+    return comma != NULL && strncmp(comma + 1, "cold", 4) == 0;
+}
+
 static void plot_group(const char *output_file, const char *title,
                        const char *algorithms[], int count,
                        const char *pattern_filter,
@@ -76,10 +82,23 @@ static void plot_group(const char *output_file, const char *title,
         char pattern[MAX_NAME_LENGTH];
         int size;
         double time;
+        int threads, runs;
+        double min_time, median_time, mean_time, p95_time;
+
+        if (is_cold_row(line)) {
+            continue;
+        }
 
-        if (sscanf(line, "%63[^,],%63[^,],%d,%lf", algo, pattern, &size, &time) != 4) {
+        int fields = sscanf(line, "%63[^,],%63[^,],%d,%lf,%d,%d,%lf,%lf,%lf,%lf", algo, pattern,
+                            &size, &time, &threads, &runs, &min_time, &median_time, &mean_time, &p95_time);
+        if (fields < 4) {
             continue;
         }
+        // Error bars span min..p95 of the trials; single-time rows (older CSVs) get none
+        if (fields < 10) {
+            min_time = time;
+            p95_time = time;
+        }
 
         if (pattern_filter != NULL && strcmp(pattern, pattern_filter) != 0) {
             continue;
@@ -87,7 +106,7 @@ static void plot_group(const char *output_file, const char *title,
 
         for (int i = 0; i < count; i++) {
             if (strcmp(algo, algorithms[i]) == 0) {
-                fprintf(temp_files[i], "%d,%lf\n", size, time);
+                fprintf(temp_files[i], "%d,%lf,%lf,%lf\n", size, time, min_time, p95_time);
                 data_counts[i]++;  // Count data points
                 if (i == 0) {
                     if (reference_size <= 0.0 || size < reference_size) {
@@ -157,6 +176,10 @@ cleanup:
     fprintf(gp, "set style line 3 lc rgb '#4daf4a' lt 1 lw 3 pt 9 ps 1.5\n");  // Green, triangle
     fprintf(gp, "set style line 4 lc rgb '#984ea3' lt 1 lw 3 pt 13 ps 1.5\n"); // Purple, diamond
     fprintf(gp, "set style line 5 lc rgb '#ff7f00' lt 1 lw 3 pt 11 ps 1.5\n"); // Orange, inverted triangle
+    fprintf(gp, "set style line 6 lc rgb '#a65628' lt 1 lw 3 pt 15 ps 1.5\n"); // Brown, pentagon
+    fprintf(gp, "set style line 7 lc rgb '#f781bf' lt 1 lw 3 pt 4 ps 1.5\n");  // Pink, open square
+    fprintf(gp, "set style line 8 lc rgb '#666666' lt 1 lw 3 pt 6 ps 1.5\n");  // Gray, open circle
+    fprintf(gp, "set style line 9 lc rgb '#17becf' lt 1 lw 3 pt 8 ps 1.5\n");  // Cyan, open triangle
     fprintf(gp, "set style line 100 lc rgb '#888888' lt 1 lw 2 dt 3\n");       // Trend line (dashed gray)
 
     double trend_factor = 0.0;
@@ -191,7 +214,7 @@ cleanup:
 
     fprintf(gp, "plot ");
     for (int i = 0; i < count; i++) {
-        fprintf(gp, "'%s' using 1:2 with linespoints ls %d title '%s (n=%d)'",
+        fprintf(gp, "'%s' using 1:2:3:4 with yerrorlines ls %d title '%s (n=%d)'",
                 temp_paths[i], i + 1, algorithms[i], data_counts[i]);
         if (i < count - 1 || trend != TREND_NONE) {
             fprintf(gp, ", \\\n     ");
@@ -330,17 +353,45 @@ void plot_size_comparison(const char *output_file) {
     plot_group("1_basic_sorts_linear.png", "O(n²) Sorting Algorithms Performance (linear scale)",
                basic_sorts, 3, "Random", false, TREND_N2);
 
-    const char *efficient_sorts[] = {"MergeSort", "QuickSort", "HeapSort"};
+    const char *efficient_sorts[] = {"MergeSort", "QuickSort", "HeapSort", "ParallelQuickSort",
+                                     "MergeSortBottomUp", "ParallelMergeSort", "IntroSort",
+                                     "BlockQuickSort", "ParallelSampleSort"};
     plot_group("2_efficient_sorts_log.png", "O(n log n) Sorting Algorithms Performance (log scale)",
-               efficient_sorts, 3, "Random", true, TREND_NLOGN);
+               efficient_sorts, 9, "Random", true, TREND_NLOGN);
     plot_group("2_efficient_sorts_linear.png", "O(n log n) Sorting Algorithms Performance (linear scale)",
-               efficient_sorts, 3, "Random", false, TREND_NLOGN);
+               efficient_sorts, 9, "Random", false, TREND_NLOGN);
 
-    const char *special_sorts[] = {"ShellSort", "CountingSort", "RadixSort", "BucketSort"};
+    const char *heap_sorts[] = {"HeapSort", "HeapSort4ary", "HeapSort8ary"};
+    plot_group("2_heap_sorts_log.png", "Heap Sort Layouts: binary vs 4-ary vs 8-ary (log scale)",
+               heap_sorts, 3, "Random", true, TREND_NLOGN);
+
+    const char *special_sorts[] = {"ShellSort", "CountingSort", "RadixSort", "BucketSort",
+                                   "RadixSort11", "RadixSort16", "ParallelRadixSort",
+                                   "CountingSortRange", "ParallelCountingSort", "AutoSort"};
     plot_group("3_special_sorts_log.png", "Special Sorting Algorithms Performance (log scale)",
-               special_sorts, 4, "Random", true, TREND_NONE);
+               special_sorts, 10, "Random", true, TREND_NONE);
     plot_group("3_special_sorts_linear.png", "Special Sorting Algorithms Performance (linear scale)",
-               special_sorts, 4, "Random", false, TREND_NONE);
+               special_sorts, 10, "Random", false, TREND_NONE);
+
+    const char *shell_sorts[] = {"ShellSort", "ShellSortCiura", "ShellSortTokuda",
+                                 "ShellSortSedgewick", "ShellSortPratt"};
+    plot_group("3_shell_gaps_log.png", "Shell Sort Gap Sequences (log scale)",
+               shell_sorts, 5, "Random", true, TREND_NLOGN);
+
+    const char *typed_radix[] = {"RadixSort", "RadixSortI64", "RadixSortU64", "RadixSortF32", "RadixSortF64"};
+    plot_group("4_typed_radix_log.png", "Radix Sort by key type: int32 / int64 / uint64 / float / double (log scale)",
+               typed_radix, 5, "Random", true, TREND_N);
+
+    // Keys-only engine next to the same engine moving 4- and 8-byte payloads
+    const char *record_radix[] = {"RadixSort", "RadixRecord32", "RadixSoA", "RadixRecord64"};
+    plot_group("4_record_radix_log.png", "Radix Sort: keys only vs key + payload layouts (log scale)",
+               record_radix, 4, "Random", true, TREND_N);
+    const char *record_merge[] = {"MergeSortBottomUp", "MergeRecord32", "MergeSoA", "MergeRecord64"};
+    plot_group("4_record_merge_log.png", "Merge Sort: keys only vs key + payload layouts (log scale)",
+               record_merge, 4, "Random", true, TREND_NLOGN);
+    const char *record_quick[] = {"QuickSort", "QuickRecord32", "QuickSoA", "QuickRecord64"};
+    plot_group("4_record_quick_log.png", "Quick Sort: keys only vs key + payload layouts (log scale)",
+               record_quick, 4, "Random", true, TREND_NLOGN);
 
     const char *basic_best_case[] = {"BubbleSort", "InsertionSort"};
     plot_group("1_basic_sorts_best_linear.png", "Near O(n) Best-Case Performance (sorted input)",
@@ -354,7 +405,7 @@ void plot_pattern_comparison(void) {
         return;
     }
 
-    PatternEntry entries[32];
+    PatternEntry entries[64];
     int entry_count = 0;
     memset(entries, 0, sizeof(entries));
 
@@ -371,7 +422,8 @@ void plot_pattern_comparison(void) {
         int size;
         double time;
 
-        if (sscanf(line, "%63[^,],%63[^,],%d,%lf", algo, pattern, &size, &time) != 4) {
+        if (is_cold_row(line) ||
+            sscanf(line, "%63[^,],%63[^,],%d,%lf", algo, pattern, &size, &time) != 4) {
             continue;
         }
 
@@ -410,7 +462,13 @@ void plot_pattern_comparison(void) {
     const char *special_algorithms[] = {
         "CountingSort",
         "RadixSort",
-        "BucketSort"
+        "BucketSort",
+        "RadixSort11",
+        "RadixSort16",
+        "ParallelRadixSort",
+        "CountingSortRange",
+        "ParallelCountingSort",
+        "AutoSort"
     };
 
     const char *quadratic_algorithms[] = {
@@ -423,7 +481,15 @@ void plot_pattern_comparison(void) {
         "MergeSort",
         "QuickSort",
         "HeapSort",
-        "ShellSort"
+        "ShellSort",
+        "ParallelQuickSort",
+        "MergeSortBottomUp",
+        "ParallelMergeSort",
+        "IntroSort",
+        "BlockQuickSort",
+        "HeapSort4ary",
+        "HeapSort8ary",
+        "ParallelSampleSort"
     };
 
     plot_pattern_subset("pattern_comparison_quadratic.png",
@@ -438,6 +504,20 @@ void plot_pattern_comparison(void) {
                         efficient_algorithms,
                         ARRAY_SIZE(efficient_algorithms));
 
+    const char *shell_algorithms[] = {
+        "ShellSort",
+        "ShellSortCiura",
+        "ShellSortTokuda",
+        "ShellSortSedgewick",
+        "ShellSortPratt"
+    };
+
+    plot_pattern_subset("pattern_comparison_shell.png",
+                        "Shell Sort Gap Sequences by Data Pattern",
+                        entries, entry_count,
+                        shell_algorithms,
+                        ARRAY_SIZE(shell_algorithms));
+
     plot_pattern_subset("pattern_comparison_special.png",
                         "Non-Comparison Algorithms by Data Pattern",
                         entries, entry_count,
@@ -461,8 +541,12 @@ void generate_all_plots() {
     printf("  - 1_basic_sorts_log.png / 1_basic_sorts_linear.png\n");
     printf("  - 1_basic_sorts_best_linear.png (Bubble, Insertion sorted input)\n");
     printf("  - 2_efficient_sorts_log.png / 2_efficient_sorts_linear.png\n");
+    printf("  - 2_heap_sorts_log.png (binary vs d-ary heap layouts)\n");
     printf("  - 3_special_sorts_log.png / 3_special_sorts_linear.png\n");
     printf("  - pattern_comparison_quadratic.png (Selection, Bubble, Insertion)\n");
-    printf("  - pattern_comparison_efficient.png (Merge, Quick, Heap, Shell)\n");
-    printf("  - pattern_comparison_special.png (Counting, Radix, Bucket)\n");
+    printf("  - pattern_comparison_efficient.png (Merge variants, Quick variants, Heap, Shell, Intro)\n");
+    printf("  - 3_shell_gaps_log.png / pattern_comparison_shell.png (Shell gap sequences)\n");
+    printf("  - pattern_comparison_special.png (Counting variants, Radix variants, Bucket)\n");
+    printf("  - 4_typed_radix_log.png (int64, uint64, float, double keys)\n");
+    printf("  - 4_record_{radix,merge,quick}_log.png (key + payload layouts)\n");
 }